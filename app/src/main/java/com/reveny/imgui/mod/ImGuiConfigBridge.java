@@ -0,0 +1,9 @@
+package com.reveny.imgui.mod;
+
+/**
+ * JNI Bridge for the native menu configuration (ImGuiConfig)
+ */
+public class ImGuiConfigBridge {
+    // Native method declarations, registered by libModMenu.so's loadJNI()
+    public static native void nativeRequestFlush();
+}
\ No newline at end of file
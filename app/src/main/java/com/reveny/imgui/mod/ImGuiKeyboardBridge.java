@@ -1,7 +1,13 @@
 package com.reveny.imgui.mod;
 
+import android.text.TextUtils;
 import android.util.Log;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.CharBuffer;
+import java.nio.IntBuffer;
+
 /**
  * JNI Bridge for ImGui keyboard integration
  * This class provides native methods to communicate between Java and C++
@@ -11,15 +17,36 @@ public class ImGuiKeyboardBridge {
     
     // Native method declarations
     public static native void nativeOnTextInput(String text);
+    public static native void nativeOnTextEdit(int offset, int removed, String inserted, int cursor);
+    public static native void nativeOnSharedTextEdit(int sequence);
+    public static native void nativeOnSharedEditApplied(int sequence);
+    public static native void nativeOnComposingChanged(int start, int end);
     public static native void nativeOnKeyDown(int keyCode);
     public static native void nativeOnKeyUp(int keyCode);
     public static native void nativeOnKeyboardShow();
     public static native void nativeOnKeyboardHide();
-    public static native void nativeSetInputFocus(boolean focused);
-    public static native void nativeSetInputText(String text);
-    public static native String nativeGetInputText();
-    public static native void nativeSetCursorPosition(int position);
-    public static native int nativeGetCursorPosition();
+    
+    // Shared text channel layout, mirrored in ImGuiSoftKeyboard.h: SHARED_HEADER_INTS ints then up to
+    // SHARED_TEXT_CAPACITY UTF-16 units. SHARED_BASE is the last sequence of the other direction the writer had
+    // applied, an edit made before the reader's latest one has stale offsets
+    private static final int SHARED_HEADER_INTS = 8;
+    private static final int SHARED_TEXT_CAPACITY = 16384;
+    private static final int SHARED_SEQUENCE = 0;
+    private static final int SHARED_OFFSET = 1;
+    private static final int SHARED_REMOVED = 2;
+    private static final int SHARED_LENGTH = 3;
+    private static final int SHARED_CURSOR = 4;
+    private static final int SHARED_BASE = 5;
+    
+    // Direct buffers over native memory, set by native code when it loads. Edits are written there and signaled
+    // with their sequence number, no string crosses JNI
+    private static IntBuffer sToNativeHeader;
+    private static CharBuffer sToNativeText;
+    private static IntBuffer sToJavaHeader;
+    private static CharBuffer sToJavaText;
+    private static int sToNativeSequence;
+    private static int sAppliedNativeSequence;
+    private static final char[] sCharScratch = new char[SHARED_TEXT_CAPACITY];
     
     // Static instance for singleton pattern
     private static ImGuiKeyboardBridge sInstance;
@@ -33,6 +60,42 @@ public class ImGuiKeyboardBridge {
             nativeOnTextInput(text);
         }
         
+        @Override
+        public void onTextEdit(CharSequence text, int start, int before, int count) {
+            if (sToNativeText == null) {
+                nativeOnTextEdit(start, before, text.subSequence(start, start + count).toString(), start + count);
+                return;
+            }
+            
+            // Inserted text longer than the channel is sent as several edits, split between characters
+            final int end = start + count;
+            int offset = start;
+            int removed = before;
+            do {
+                int chunkEnd = Math.min(end, offset + SHARED_TEXT_CAPACITY);
+                if (chunkEnd < end && Character.isHighSurrogate(text.charAt(chunkEnd - 1))) {
+                    chunkEnd--;
+                }
+                TextUtils.getChars(text, offset, chunkEnd, sCharScratch, 0);
+                sToNativeText.clear();
+                sToNativeText.put(sCharScratch, 0, chunkEnd - offset);
+                sToNativeHeader.put(SHARED_OFFSET, offset);
+                sToNativeHeader.put(SHARED_REMOVED, removed);
+                sToNativeHeader.put(SHARED_LENGTH, chunkEnd - offset);
+                sToNativeHeader.put(SHARED_CURSOR, chunkEnd);
+                sToNativeHeader.put(SHARED_BASE, sAppliedNativeSequence);
+                sToNativeHeader.put(SHARED_SEQUENCE, ++sToNativeSequence);
+                nativeOnSharedTextEdit(sToNativeSequence);
+                offset = chunkEnd;
+                removed = 0;
+            } while (offset < end);
+        }
+        
+        @Override
+        public void onComposingChanged(int start, int end) {
+            nativeOnComposingChanged(start, end);
+        }
+        
         @Override
         public void onKeyDown(int keyCode) {
             Log.d(TAG, "Key down: " + keyCode);
@@ -192,6 +255,58 @@ public class ImGuiKeyboardBridge {
         return sInstance != null ? sInstance.getText() : "";
     }
     
+    /**
+     * Receive the shared text buffers, called by native code when it loads
+     */
+    public static void setSharedBuffersStatic(ByteBuffer toNative, ByteBuffer toJava) {
+        toNative.order(ByteOrder.nativeOrder());
+        toJava.order(ByteOrder.nativeOrder());
+        sToNativeHeader = toNative.asIntBuffer();
+        sToJavaHeader = toJava.asIntBuffer();
+        toNative.position(SHARED_HEADER_INTS * 4);
+        toJava.position(SHARED_HEADER_INTS * 4);
+        sToNativeText = toNative.slice().order(ByteOrder.nativeOrder()).asCharBuffer();
+        sToJavaText = toJava.slice().order(ByteOrder.nativeOrder()).asCharBuffer();
+    }
+    
+    /**
+     * Apply the edit native code wrote to the shared buffer, called on the native ImGuiJniWorker thread. The header and
+     * the text are copied here, the UI thread only sees the copy: native code does not write the buffer again until
+     * nativeOnSharedEditApplied(), or until it gives up waiting after a second. A copy that raced with such a rewrite
+     * no longer finds its sequence in the header and is dropped, native code sends the whole text next.
+     * An edit made before native code received our latest edit is dropped: native code drops that edit too and sends
+     * the whole text instead (removed is -1 then, which does not depend on offsets)
+     */
+    public static void applySharedEditStatic(final int sequence) {
+        final int offset = sToJavaHeader.get(SHARED_OFFSET);
+        final int removed = sToJavaHeader.get(SHARED_REMOVED);
+        final int cursor = sToJavaHeader.get(SHARED_CURSOR);
+        final int base = sToJavaHeader.get(SHARED_BASE);
+        String text = null;
+        if (offset >= 0) {
+            CharBuffer shared = sToJavaText.duplicate();
+            shared.limit(Math.max(0, Math.min(sToJavaHeader.get(SHARED_LENGTH), SHARED_TEXT_CAPACITY)));
+            text = shared.toString();
+        }
+        final String inserted = text;
+        
+        final SoftKeyboardManager manager = sInstance != null ? sInstance.mKeyboardManager : null;
+        if (manager == null || sToJavaHeader.get(SHARED_SEQUENCE) != sequence) {
+            nativeOnSharedEditApplied(sequence);
+            return;
+        }
+        manager.runOnUiThread(() -> {
+            try {
+                if (removed < 0 || base >= sToNativeSequence) {
+                    manager.applyEdit(offset, removed, inserted, cursor);
+                }
+            } finally {
+                sAppliedNativeSequence = sequence;
+                nativeOnSharedEditApplied(sequence);
+            }
+        });
+    }
+    
     public static void setCursorPositionStatic(int position) {
         if (sInstance != null) {
             sInstance.setCursorPosition(position);
@@ -60,6 +60,13 @@ public class MainActivity extends Activity {
         }
     }
     
+    @Override
+    protected void onPause() {
+        super.onPause();
+        // No frame follows: the config writer saves the values it has now instead of after the save delay
+        ImGuiConfigBridge.nativeRequestFlush();
+    }
+    
     @Override
     protected void onDestroy() {
         super.onDestroy();
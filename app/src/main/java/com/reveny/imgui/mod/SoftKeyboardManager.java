@@ -5,6 +5,7 @@ import android.content.Context;
 import android.inputmethodservice.InputMethodService;
 import android.os.Build;
 import android.view.View;
+import android.view.inputmethod.BaseInputConnection;
 import android.view.inputmethod.EditorInfo;
 import android.view.inputmethod.InputMethodManager;
 import android.widget.EditText;
@@ -28,10 +29,15 @@ public class SoftKeyboardManager {
     private FrameLayout mKeyboardContainer;
     private boolean mIsKeyboardVisible = false;
     private boolean mIsInitialized = false;
+    private boolean mIsApplyingEdits = false;
+    private int mComposingStart = -1;
+    private int mComposingEnd = -1;
     
     // Callback interface for keyboard events
     public interface KeyboardCallback {
         void onTextInput(String text);
+        void onTextEdit(CharSequence text, int start, int before, int count);
+        void onComposingChanged(int start, int end);
         void onKeyDown(int keyCode);
         void onKeyUp(int keyCode);
         void onKeyboardShow();
@@ -65,12 +71,22 @@ public class SoftKeyboardManager {
             public void beforeTextChanged(CharSequence s, int start, int count, int after) {}
             
             @Override
-            public void onTextChanged(CharSequence s, int start, int before, int count) {}
+            public void onTextChanged(CharSequence s, int start, int before, int count) {
+                // Only the changed range is sent, edits coming from native code are not echoed back
+                if (mCallback != null && !mIsApplyingEdits) {
+                    mCallback.onTextEdit(s, start, before, count);
+                }
+            }
             
             @Override
             public void afterTextChanged(android.text.Editable s) {
-                if (mCallback != null) {
-                    mCallback.onTextInput(s.toString());
+                // The IME composing span (the word being typed), sent when it changes
+                int start = BaseInputConnection.getComposingSpanStart(s);
+                int end = BaseInputConnection.getComposingSpanEnd(s);
+                if (mCallback != null && (start != mComposingStart || end != mComposingEnd)) {
+                    mComposingStart = start;
+                    mComposingEnd = end;
+                    mCallback.onComposingChanged(start, end);
                 }
             }
         });
@@ -188,6 +204,37 @@ public class SoftKeyboardManager {
         }
     }
     
+    /**
+     * Run an action on the UI thread, where the EditText is edited
+     */
+    public void runOnUiThread(Runnable action) {
+        mActivity.runOnUiThread(action);
+    }
+    
+    /**
+     * Apply an edit sent by native code, on the UI thread: removed characters at offset replaced by inserted, then the
+     * cursor moved. inserted is null when only the cursor changed, removed is -1 to replace the whole text and cursor
+     * is -1 when it did not change
+     */
+    public void applyEdit(int offset, int removed, CharSequence inserted, int cursor) {
+        if (mHiddenEditText == null) return;
+        
+        mIsApplyingEdits = true;
+        try {
+            if (inserted != null) {
+                android.text.Editable text = mHiddenEditText.getText();
+                int start = removed < 0 ? 0 : Math.min(offset, text.length());
+                int end = removed < 0 ? text.length() : Math.min(start + removed, text.length());
+                text.replace(start, end, inserted);
+            }
+            if (cursor >= 0) {
+                mHiddenEditText.setSelection(Math.min(cursor, mHiddenEditText.length()));
+            }
+        } finally {
+            mIsApplyingEdits = false;
+        }
+    }
+    
     /**
      * Set cursor position
      */
@@ -0,0 +1,182 @@
+//
+// Host benchmark of ImGuiAutocomplete
+// Built and run by ./bench_imgui.sh Autocomplete. 200k generated Il2Cpp style names ("get_PlayerHealth",
+// "UnityEngine.Rigidbody", "m_maxAmmoCount"...) are indexed on ImGuiWorkerPool, then words are pasted, typed one
+// character at a time and erased again, as in a search box. The time of query() is reported (average,
+// 99th percentile, worst wall clock and CPU time of the calling thread) and every result is checked against a brute force scan of the
+// names: same matching rule (case-insensitive prefix of a word), same ranking, each entry at most once.
+//
+
+#include "../Include/ImGuiAutocomplete.h"
+#include "../Include/ImGuiTableSorter.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <time.h>
+
+static const int ENTRY_COUNT = 200000;
+static const int MAX_RESULTS = 20;
+static const int CHECKED_QUERIES = 300;
+
+static const char* const WORDS[] = {
+    "player", "health", "max", "ammo", "count", "weapon", "damage", "speed", "camera", "transform", "position",
+    "rotation", "target", "enemy", "bullet", "reload", "time", "manager", "controller", "game", "object", "component",
+    "network", "sync", "state", "update", "view", "model", "skin", "level", "score", "team", "spawn", "point", "rigid",
+    "body", "collider", "mesh", "renderer", "input", "touch", "button", "text", "ui", "panel", "item", "inventory",
+    "slot", "shop", "price", "coin", "gem", "http", "server", "client", "request", "response", "data", "config",
+    "value", "list", "dictionary", "array", "string", "int32", "single", "boolean", "vector3", "quaternion", "is",
+    "can", "has", "aim", "fire", "shoot", "jump", "crouch", "run", "walk", "move", "look", "audio", "sound", "effect",
+};
+static const char* const NAMESPACES[] = { "UnityEngine.", "System.Collections.Generic.", "Photon.Pun.", "Game.Core.", "" };
+
+// CPU time of the calling thread, which leaves out preemption (by the pool thread freeing the build input, among others)
+static double threadCpuUs() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return (double)time.tv_sec * 1e6 + (double)time.tv_nsec / 1e3;
+}
+
+static std::string capitalized(const char* word) {
+    std::string result(word);
+    result[0] = (char)(result[0] - 'a' + 'A');
+    return result;
+}
+
+// Method, property accessor, field or namespaced class name made of 1-4 words, with a number now and then
+static std::string generateName(std::mt19937& rng) {
+    static const int WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+    std::string name;
+    const int style = (int)(rng() % 5);
+    if (style == 0) name = rng() % 2 ? "get_" : "set_";
+    else if (style == 1) name = "m_";
+    else if (style == 2) name = NAMESPACES[rng() % (sizeof(NAMESPACES) / sizeof(NAMESPACES[0]))];
+    const int words = 1 + (int)(rng() % 4);
+    for (int n = 0; n < words; n++) {
+        const char* word = WORDS[rng() % WORD_COUNT];
+        name += (style == 1 && n == 0) ? std::string(word) : capitalized(word);
+    }
+    if (rng() % 8 == 0)
+        name += std::to_string(rng() % 100);
+    return name;
+}
+
+// Same rules as ImGuiAutocomplete: words split on camelCase, digits and separators, ASCII case folding
+static bool isWordChar(char c) { return isalnum((unsigned char)c) || (unsigned char)c >= 0x80; }
+static bool isWordStart(const char* name, int i) {
+    const char c = name[i];
+    if (!isWordChar(c)) return false;
+    if (i == 0 || !isWordChar(name[i - 1])) return true;
+    const char previous = name[i - 1];
+    if (isupper((unsigned char)c) && islower((unsigned char)previous)) return true;
+    if (isupper((unsigned char)c) && isupper((unsigned char)previous) && islower((unsigned char)name[i + 1])) return true;
+    return (isdigit((unsigned char)c) != 0) != (isdigit((unsigned char)previous) != 0);
+}
+static bool matchesAt(const char* name, int i, const std::string& query) {
+    for (size_t n = 0; n < query.size(); n++)
+        if (tolower((unsigned char)name[i + n]) != (unsigned char)query[n])
+            return false;
+    return true;
+}
+
+// Score of a match of 'query' at name[i] (priority, match at the start, shorter names), 0 when it does not match there
+static uint32_t scoreAt(const std::string& name, int priority, const std::string& query, int i) {
+    if (!isWordStart(name.c_str(), i) || !matchesAt(name.c_str(), i, query))
+        return 0;
+    return ((uint32_t)priority << 24) | ((i == 0 ? 1u : 0u) << 23) | (uint32_t)(0x7FFFFF - (int)name.size());
+}
+
+// Best score of an entry, 0 when no word matches
+static uint32_t bruteForceScore(const std::string& name, int priority, const std::string& query) {
+    uint32_t best = 0;
+    for (int i = 0; i < (int)name.size(); i++)
+        best = std::max(best, scoreAt(name, priority, query, i));
+    return best;
+}
+
+// The results must be distinct entries, each reported at a matching word with its best score, and their scores must
+// be the best MAX_RESULTS scores of the brute force scan in order (ties between entries or between words of an entry
+// can be broken either way)
+static bool checkResults(const std::vector<std::string>& names, const std::vector<int>& priorities, const std::string& query,
+                         const std::vector<ImGuiAutocomplete::Match>& results) {
+    std::vector<uint32_t> expected;
+    for (int entry = 0; entry < (int)names.size(); entry++)
+        if (uint32_t score = bruteForceScore(names[entry], priorities[entry], query))
+            expected.push_back(score);
+    std::sort(expected.begin(), expected.end(), std::greater<uint32_t>());
+    expected.resize(std::min(expected.size(), (size_t)MAX_RESULTS));
+    if (results.size() != expected.size())
+        return false;
+    for (size_t n = 0; n < results.size(); n++) {
+        const ImGuiAutocomplete::Match& match = results[n];
+        if (scoreAt(names[match.entry], priorities[match.entry], query, match.offset) != expected[n])
+            return false;
+        for (size_t previous = 0; previous < n; previous++)
+            if (results[previous].entry == match.entry)
+                return false;
+    }
+    return true;
+}
+
+int main() {
+    std::mt19937 rng(9);
+    std::vector<std::string> names(ENTRY_COUNT);
+    std::vector<int> priorities(ENTRY_COUNT);
+    for (int n = 0; n < ENTRY_COUNT; n++) {
+        names[n] = generateName(rng);
+        priorities[n] = (rng() % 50 == 0) ? 1 + (int)(rng() % 3) : 0;
+    }
+    printf("cores: %u, pool threads: %d, %d names\n", std::thread::hardware_concurrency(), ImGuiWorkerPool::getInstance().getThreadCount(), ENTRY_COUNT);
+
+    ImGuiAutocomplete autocomplete;
+    const auto buildStart = std::chrono::steady_clock::now();
+    autocomplete.setEntries(names, priorities);
+    while (autocomplete.query("a", MAX_RESULTS), autocomplete.isBuilding())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    printf("index build: %.0f ms on the pool\n", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count());
+
+    // Words of the vocabulary and fragments that match nothing, typed and erased one character at a time. One in 5 is
+    // pasted first, which queries it without a previous range to narrow
+    std::vector<std::string> typed;
+    for (int n = 0; n < 400; n++) {
+        std::string word = WORDS[rng() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+        if (n % 10 == 0) word += "zq";
+        else if (n % 3 == 0) word += WORDS[rng() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+        if (n % 5 == 0)
+            typed.push_back(word);
+        for (size_t length = 1; length <= word.size(); length++)
+            typed.push_back(word.substr(0, length));
+        for (size_t length = word.size() - 1; length >= 1; length--)
+            typed.push_back(word.substr(0, length));
+    }
+
+    std::vector<double> times;
+    double worstCpuUs = 0.0;
+    size_t maxResults = 0;
+    int wrong = 0, checked = 0;
+    for (size_t n = 0; n < typed.size(); n++) {
+        const double cpuStart = threadCpuUs();
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<ImGuiAutocomplete::Match>& results = autocomplete.query(typed[n].c_str(), MAX_RESULTS);
+        times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        worstCpuUs = std::max(worstCpuUs, threadCpuUs() - cpuStart);
+        maxResults = std::max(maxResults, results.size());
+        if (n % (typed.size() / CHECKED_QUERIES) == 0 || results.empty()) {
+            wrong += !checkResults(names, priorities, typed[n], results);
+            checked++;
+        }
+    }
+
+    std::sort(times.begin(), times.end());
+    double total = 0.0;
+    for (double us : times)
+        total += us;
+    printf("%zu queries: avg %.1f us, p99 %.1f us, worst %.1f us (CPU time %.1f us), up to %zu results\n",
+           times.size(), total / times.size(), times[times.size() * 99 / 100], times.back(), worstCpuUs, maxResults);
+    printf("%d of %d checked queries differ from brute force\n", wrong, checked);
+    return wrong == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+//
+// Host benchmark of ImHashStr() / ImHashData(), the ID hash of every widget
+// Built and run by bench_imgui.sh, once per hash backend (see IMGUI_USE_CRC32C and IMGUI_DISABLE_HW_CRC32 in imconfig.h):
+//   table      GCrc32LookupTable, one byte per step (IMGUI_DISABLE_HW_CRC32)
+//   default    ARMv8 CRC32 instructions when the target has them (same IDs as the table), the table otherwise
+//   crc32c     CRC32C instructions, ARMv8 or x86-64 SSE4.2 (IMGUI_USE_CRC32C, different IDs)
+// Each build first checks its hashes against a bitwise reference of the expected polynomial, including the "###" reset.
+//
+
+#include "../Include/ImGui/imgui.h"
+#include "../Include/ImGui/imgui_internal.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(IMGUI_USE_CRC32C)
+static const char* const BACKEND = "crc32c";
+static const ImU32 POLYNOMIAL = 0x82F63B78u;     // Castagnoli, reflected
+#else
+static const char* const BACKEND = "crc32";
+static const ImU32 POLYNOMIAL = 0xEDB88320u;     // GCrc32LookupTable, reflected
+#endif
+
+static const int LABEL_COUNT = 300;
+static const int FRAME_COUNT = 1000;
+static const int RUNS = 30;
+
+static ImU32 referenceStep(ImU32 crc, unsigned char c) {
+    crc ^= c;
+    for (int k = 0; k < 8; k++)
+        crc = (crc >> 1) ^ (POLYNOMIAL & (0u - (crc & 1)));
+    return crc;
+}
+
+// ImHashStr() semantics bit by bit: "###" resets the hash to the seed. length 0 = zero-terminated
+static ImU32 referenceHashStr(const char* text, size_t length, ImU32 seed) {
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char* p = (const unsigned char*)text;
+    if (length) {
+        while (length-- != 0) {
+            const unsigned char c = *p++;
+            if (c == '#' && length >= 2 && p[0] == '#' && p[1] == '#')
+                crc = seed;
+            crc = referenceStep(crc, c);
+        }
+    } else {
+        while (const unsigned char c = *p++) {
+            if (c == '#' && p[0] == '#' && p[1] == '#')
+                crc = seed;
+            crc = referenceStep(crc, c);
+        }
+    }
+    return ~crc;
+}
+
+// Random strings dense in '#', through the three entry points
+static int checkAgainstReference() {
+    static const char alphabet[] = "ab#c #d";
+    unsigned int rng = 1234;
+    int mismatches = 0;
+    for (int n = 0; n < 200000; n++) {
+        char text[64];
+        const int length = (int)((rng = rng * 1103515245 + 12345) % 40);
+        for (int i = 0; i < length; i++)
+            text[i] = alphabet[((rng = rng * 1103515245 + 12345) >> 16) % 7];
+        text[length] = '\0';
+        const ImU32 seed = rng;
+        mismatches += ImHashStr(text, 0, seed) != referenceHashStr(text, 0, seed);
+        if (length)
+            mismatches += ImHashStr(text, length, seed) != referenceHashStr(text, length, seed);
+        ImU32 crc = ~seed;
+        for (int i = 0; i < length; i++)
+            crc = referenceStep(crc, (unsigned char)text[i]);
+        mismatches += ImHashData(text, length, seed) != ~crc;
+    }
+    return mismatches;
+}
+
+static double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const int mismatches = checkAgainstReference();
+    printf("%s: %d mismatches against the bitwise reference\n", BACKEND, mismatches);
+
+    static char labels[LABEL_COUNT][48];
+    for (int i = 0; i < LABEL_COUNT; i++)
+        snprintf(labels[i], sizeof(labels[i]), i % 3 ? "Enable feature %d##menu_item" : "Aimbot FOV %d", i);
+    const char* longLabel = "A much longer label used for tooltips and headers in the mod menu##section_header_long";
+
+    volatile ImU32 sink = 0;
+    double bestLabels = 1e30, bestLong = 1e30;
+    for (int run = 0; run < RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAME_COUNT; frame++)
+            for (int i = 0; i < LABEL_COUNT; i++)
+                sink += ImHashStr(labels[i], 0, 0x1234u + frame);
+        bestLabels = ImMin(bestLabels, elapsedUs(start));
+
+        start = std::chrono::steady_clock::now();
+        for (int n = 0; n < FRAME_COUNT * LABEL_COUNT; n++)
+            sink += ImHashStr(longLabel, 0, n);
+        bestLong = ImMin(bestLong, elapsedUs(start));
+    }
+    printf("%s: %d menu labels (~20 B) %.1f ns/label, %d-byte label %.1f ns (best of %d)\n", BACKEND, LABEL_COUNT,
+           bestLabels * 1000.0 / (FRAME_COUNT * LABEL_COUNT), (int)strlen(longLabel), bestLong * 1000.0 / (FRAME_COUNT * LABEL_COUNT), RUNS);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+//
+// Host benchmark of OffsetDatabase: parse time and peak RSS of the SAX loader, against a full nlohmann::json DOM
+// Built and run by bench_offsets.sh:
+//   OffsetDatabaseBench generate <file> <megabytes>    Write a random database of about that size
+//   OffsetDatabaseBench sax <file>                     Load it with OffsetDatabase::loadFile()
+//   OffsetDatabaseBench dom <file>                     Parse it into a nlohmann::json DOM (what the loader avoids)
+//   OffsetDatabaseBench arena <file>                   Parse it into an ArenaJson DOM in a MonotonicArena
+// Each mode runs in its own process so the peak RSS it reports is its own.
+//
+
+#include "../Include/ArenaJson.h"
+#include "../Include/OffsetDatabase.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <random>
+#include <sys/resource.h>
+
+// Every operator new of the process (nlohmann::json nodes and strings, std containers). The arena uses malloc()
+// for its chunks, they are reported by the arena itself. The array forms go through the scalar ones, and the
+// deletes are kept out of line: inlined into a caller, their free() would be paired with the caller's operator new
+static size_t s_newCount = 0;
+
+void* operator new(size_t size) {
+    s_newCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+// Peak resident set size of the process, in KB
+static long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int generate(const char* path, long megabytes) {
+    static const char* const classes[] = { "PlayerController", "WeaponManager", "CameraFollow", "InventorySlot", "EnemyAI", "NetworkSync" };
+    static const char* const methods[] = { "get_Health", "set_Health", "Update", "FixedUpdate", "OnDamage", "get_Position", "Fire", "Reload" };
+    std::mt19937 rng(1234);
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+    fputs("{\n\"version\": 3,\n\"game\": {\"name\": \"bench\", \"build\": \"1.0.0\"},\n\"modules\": [\"libil2cpp.so\", \"libunity.so\", \"libmain.so\"],\n\"entries\": [\n", file);
+    const long target = megabytes * 1024 * 1024;
+    for (long n = 0; ftell(file) < target; n++) {
+        fprintf(file, "%s{\"name\": \"%s_%ld.%s\", \"module\": %u, \"offset\": \"0x%X\", \"signature\": \"",
+                n ? ",\n" : "", classes[rng() % 6], n, methods[rng() % 8], (unsigned)(rng() % 3), (unsigned)(rng() & 0x3FFFFFF));
+        const int length = 12 + rng() % 20;
+        for (int i = 0; i < length; i++)
+            fprintf(file, i ? (rng() % 6 ? " %02X" : " ??") : "%02X", (unsigned)(rng() & 0xFF));
+        fputs("\", \"comment\": {\"tags\": [\"auto\", \"v3\"], \"verified\": true}}", file);
+    }
+    fputs("\n]\n}\n", file);
+    printf("Generated %s: %.1f MB\n", path, ftell(file) / (1024.0 * 1024.0));
+    fclose(file);
+    return 0;
+}
+
+static int benchSax(const char* path) {
+    const long baseline = peakRssKb();
+    const size_t newCount = s_newCount;
+    const auto start = std::chrono::steady_clock::now();
+    OffsetDatabase database;
+    std::string error;
+    if (!database.loadFile(path, &error)) {
+        fprintf(stderr, "Load failed: %s\n", error.c_str());
+        return 1;
+    }
+    const double ms = elapsedMs(start);
+    const MonotonicArena& arena = database.getArena();
+    printf("sax: %d records, %.1f ms, peak RSS +%ld KB, %zu allocations + %d arena chunks (%zu KB used)\n", database.getRecordCount(), ms,
+           peakRssKb() - baseline, s_newCount - newCount, arena.getChunkCount(), arena.getBytesUsed() / 1024);
+    return 0;
+}
+
+static int benchDom(const char* path) {
+    const long baseline = peakRssKb();
+    const size_t newCount = s_newCount;
+    const auto start = std::chrono::steady_clock::now();
+    std::ifstream file(path, std::ios::binary);
+    nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded()) {
+        fprintf(stderr, "Parse failed\n");
+        return 1;
+    }
+    const double ms = elapsedMs(start);
+    printf("dom: %zu records, %.1f ms, peak RSS +%ld KB, %zu allocations\n", json["entries"].size(), ms, peakRssKb() - baseline, s_newCount - newCount);
+    return 0;
+}
+
+static int benchArena(const char* path) {
+    const long baseline = peakRssKb();
+    const size_t newCount = s_newCount;
+    const auto start = std::chrono::steady_clock::now();
+    MonotonicArena arena(4 << 20);
+    {
+        MonotonicArena::Scope scope(arena);
+        std::ifstream file(path, std::ios::binary);
+        ArenaJson json = ArenaJson::parse(file, nullptr, false);
+        if (json.is_discarded()) {
+            fprintf(stderr, "Parse failed\n");
+            return 1;
+        }
+        const double ms = elapsedMs(start);
+        printf("arena: %zu records, %.1f ms, peak RSS +%ld KB, %zu allocations + %d arena chunks (%zu KB used)\n", json["entries"].size(), ms,
+               peakRssKb() - baseline, s_newCount - newCount, arena.getChunkCount(), arena.getBytesUsed() / 1024);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 4 && strcmp(argv[1], "generate") == 0)
+        return generate(argv[2], atol(argv[3]));
+    if (argc == 3 && strcmp(argv[1], "sax") == 0)
+        return benchSax(argv[2]);
+    if (argc == 3 && strcmp(argv[1], "dom") == 0)
+        return benchDom(argv[2]);
+    if (argc == 3 && strcmp(argv[1], "arena") == 0)
+        return benchArena(argv[2]);
+    fprintf(stderr, "Usage: %s generate <file> <megabytes> | sax <file> | dom <file> | arena <file>\n", argv[0]);
+    return 1;
+}
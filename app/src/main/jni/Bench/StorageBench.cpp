@@ -0,0 +1,92 @@
+//
+// Host benchmark of ImGuiStorage: sorted vector vs hash index backend (see ImGuiStorage::SetUseHashIndex())
+// Built and run by bench_imgui.sh. Both backends are first checked against std::map, including switches between them.
+// Then 100, 10k and 100k random keys are inserted (SetInt on new keys) and looked up (GetInt), best of RUNS.
+//
+
+#include "../Include/ImGui/imgui.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+static const int RUNS = 5;
+
+static double elapsedNs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, int count) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+// 200k mixed SetInt/GetIntRef against std::map, then a full comparison in both backends
+static int checkAgainstReference(std::mt19937& rng) {
+    int mismatches = 0;
+    for (int useHashIndex = 0; useHashIndex < 2; useHashIndex++) {
+        ImGuiStorage storage;
+        storage.SetUseHashIndex(useHashIndex != 0);
+        std::map<ImGuiID, int> reference;
+        for (int i = 0; i < 200000; i++) {
+            const ImGuiID key = rng() % 50000;
+            if (i & 1) {
+                const int value = (int)rng();
+                storage.SetInt(key, value);
+                reference[key] = value;
+            } else {
+                const int* value = storage.GetIntRef(key, 7);
+                if (!reference.count(key))
+                    reference[key] = 7;
+                mismatches += *value != reference[key];
+            }
+        }
+        for (const auto& pair : reference)
+            mismatches += storage.GetInt(pair.first, -1) != pair.second;
+        mismatches += storage.Data.Size != (int)reference.size();
+
+        storage.SetUseHashIndex(useHashIndex == 0);
+        for (const auto& pair : reference)
+            mismatches += storage.GetInt(pair.first, -1) != pair.second;
+        mismatches += storage.GetInt(0xFFFFFFFFu, -5) != -5;
+    }
+    return mismatches;
+}
+
+int main() {
+    std::mt19937 rng(1);
+    const int mismatches = checkAgainstReference(rng);
+    printf("%d mismatches against std::map\n", mismatches);
+
+    static const int KEY_COUNTS[] = { 100, 10000, 100000 };
+    for (int keyCount : KEY_COUNTS) {
+        std::vector<ImGuiID> keys(keyCount);
+        for (ImGuiID& key : keys)
+            key = rng();
+        // Small sizes are repeated so one measurement isn't a handful of nanoseconds
+        const int repeats = keyCount <= 100 ? 2000 : keyCount <= 10000 ? 10 : 1;
+        for (int useHashIndex = 0; useHashIndex < 2; useHashIndex++) {
+            double bestInsert = 1e30, bestLookup = 1e30;
+            volatile int sink = 0;
+            for (int run = 0; run < RUNS; run++) {
+                double insert = 0.0, lookup = 0.0;
+                for (int repeat = 0; repeat < repeats; repeat++) {
+                    ImGuiStorage storage;
+                    storage.SetUseHashIndex(useHashIndex != 0);
+                    auto start = std::chrono::steady_clock::now();
+                    for (ImGuiID key : keys)
+                        storage.SetInt(key, 1);
+                    auto inserted = std::chrono::steady_clock::now();
+                    for (int pass = 0; pass < 4; pass++)
+                        for (ImGuiID key : keys)
+                            sink += storage.GetInt(key);
+                    auto end = std::chrono::steady_clock::now();
+                    insert += elapsedNs(start, inserted, keyCount);
+                    lookup += elapsedNs(inserted, end, keyCount * 4);
+                }
+                bestInsert = std::min(bestInsert, insert / repeats);
+                bestLookup = std::min(bestLookup, lookup / repeats);
+            }
+            printf("%6d keys %-6s SetInt (new key) %8.1f ns/key  GetInt %6.1f ns/key\n", keyCount,
+                   useHashIndex ? "hash" : "sorted", bestInsert, bestLookup);
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+//
+// Host benchmark of ImGuiStreamingPlot
+// Built and run by ./bench_imgui.sh StreamingPlot. The min/max tree is first checked against a brute force scan of a
+// copy of the samples: single and batched pushes (batches larger than the capacity included), wraparound, clear() and
+// NaN samples, on random ranges and on the pixel columns of a 600 px plot. Then the per-frame cost of a 600 px plot of
+// 1M samples is timed while 1000 new samples arrive each frame, against ImGui::PlotLines() over the same samples, and
+// the cost of push() per sample is reported.
+//
+
+#include "../Include/ImGuiStreamingPlot.h"
+#include "../Include/ImGui/imgui_internal.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+static const int PLOT_WIDTH = 600;
+static const int FRAME_COUNT = 300;
+static const int WARMUP_FRAMES = 20;
+static const int SAMPLES_PER_FRAME = 1000;
+
+static double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compare getRange() with a scan of 'expected' (the stored samples, oldest first)
+static bool checkRange(const ImGuiStreamingPlot& plot, const std::vector<float>& expected, int first, int count) {
+    float min = FLT_MAX, max = -FLT_MAX;
+    for (int n = first; n < first + count; n++) {
+        if (expected[n] != expected[n])
+            continue;
+        min = ImMin(min, expected[n]);
+        max = ImMax(max, expected[n]);
+    }
+    float treeMin = 0.0f, treeMax = 0.0f;
+    const bool found = plot.getRange(first, count, &treeMin, &treeMax);
+    if (min > max)
+        return !found;
+    return found && treeMin == min && treeMax == max;
+}
+
+// Random pushes checked after every step. Returns the number of wrong ranges
+static int checkAgainstBruteForce(std::mt19937& rng) {
+    static const int CAPACITIES[] = { 2, 100, 4096, 65536 };
+    int mismatches = 0;
+    for (int capacity : CAPACITIES) {
+        ImGuiStreamingPlot plot(capacity);
+        std::vector<float> history; // Every sample pushed since the last clear()
+        std::vector<float> batch;
+        for (int step = 0; step < 400; step++) {
+            const int action = (int)(rng() % 100);
+            if (action == 0) {
+                plot.clear();
+                history.clear();
+            } else if (action < 50) {
+                // Mostly small values, with spikes and NaN
+                const float value = (rng() % 50 == 0) ? NAN : (rng() % 20 == 0) ? (float)(rng() % 100000) : (float)(rng() % 100) * 0.5f - 10.0f;
+                plot.push(value);
+                history.push_back(value);
+            } else {
+                const int count = (int)(rng() % (action < 95 ? 64u : (unsigned int)plot.getCapacity() * 3 + 1));
+                batch.resize(count);
+                for (float& value : batch)
+                    value = (rng() % 100 == 0) ? NAN : (float)(rng() % 1000) - 500.0f;
+                plot.push(batch.data(), count);
+                history.insert(history.end(), batch.begin(), batch.end());
+            }
+
+            const int count = (int)ImMin(history.size(), (size_t)plot.getCapacity());
+            const float last = plot.getLast();
+            if (plot.getCount() != count || (count > 0 && last != history.back() && (last == last || history.back() == history.back()))) {
+                mismatches++;
+                continue;
+            }
+            const std::vector<float> expected(history.end() - count, history.end());
+            for (int query = 0; query < 16 && count > 0; query++) {
+                const int first = (int)(rng() % count);
+                mismatches += !checkRange(plot, expected, first, 1 + (int)(rng() % (count - first)));
+            }
+            // The columns plot() queries
+            if (step % 50 == 0) {
+                const int columns = ImClamp(PLOT_WIDTH, 1, ImMax(count, 1));
+                for (int n = 0; n < columns && count > 0; n++) {
+                    const int first = (int)((long long)n * count / columns);
+                    const int last = (int)((long long)(n + 1) * count / columns);
+                    mismatches += !checkRange(plot, expected, first, last - first);
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Synthetic frame times around 16 ms with rare spikes
+static float nextSample(std::mt19937& rng) {
+    return (rng() % 1000 == 0) ? 50.0f + (float)(rng() % 50) : 16.0f + (float)(rng() % 100) * 0.01f;
+}
+
+// One frame drawing the plot with 'draw' in a full screen window. Returns the time of the draw
+template<typename Draw>
+static double plotFrame(Draw&& draw) {
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Bench", NULL, ImGuiWindowFlags_NoDecoration);
+    const auto start = std::chrono::steady_clock::now();
+    draw();
+    const double us = elapsedUs(start);
+    ImGui::End();
+    ImGui::Render();
+    return us;
+}
+
+// Average and worst time of 'draw' over the timed frames, after pushing SAMPLES_PER_FRAME samples with 'push'
+template<typename Push, typename Draw>
+static void timeFrames(const char* name, Push&& push, Draw&& draw) {
+    double total = 0.0, worst = 0.0;
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        push();
+        const double us = plotFrame(draw);
+        if (frame < WARMUP_FRAMES)
+            continue;
+        total += us;
+        worst = ImMax(worst, us);
+    }
+    printf("%-34s avg %7.1f us, worst %7.1f us per frame\n", name, total / (FRAME_COUNT - WARMUP_FRAMES), worst);
+}
+
+int main() {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.IniFilename = NULL;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    std::mt19937 rng(5);
+    const int mismatches = checkAgainstBruteForce(rng);
+    printf("%d mismatches against brute force min/max\n", mismatches);
+
+    static const int SAMPLE_COUNT = 1 << 20;
+    ImGuiStreamingPlot plot(SAMPLE_COUNT);
+    std::vector<float> samples(SAMPLE_COUNT); // Same samples for ImGui::PlotLines(), oldest first
+    int samplesOffset = 0;
+    for (float& value : samples)
+        value = nextSample(rng);
+    plot.push(samples.data(), SAMPLE_COUNT);
+
+    std::vector<float> batch(SAMPLES_PER_FRAME);
+    auto pushBatch = [&]() {
+        for (float& value : batch)
+            value = nextSample(rng);
+        plot.push(batch.data(), SAMPLES_PER_FRAME);
+        for (float value : batch) {
+            samples[samplesOffset] = value;
+            samplesOffset = (samplesOffset + 1) % SAMPLE_COUNT;
+        }
+    };
+    const ImVec2 size((float)PLOT_WIDTH, 80.0f);
+    printf("1M samples, %d px plot, %d new samples per frame:\n", PLOT_WIDTH, SAMPLES_PER_FRAME);
+    timeFrames("streaming plotLines(), auto scale", pushBatch, [&]() { plot.plotLines("lines", NULL, FLT_MAX, FLT_MAX, size); });
+    timeFrames("streaming plotLines(), fixed scale", pushBatch, [&]() { plot.plotLines("lines", NULL, 0.0f, 100.0f, size); });
+    timeFrames("streaming plotHistogram()", pushBatch, [&]() { plot.plotHistogram("histogram", NULL, 0.0f, 100.0f, size); });
+    timeFrames("PlotLines(), auto scale", pushBatch, [&]() { ImGui::PlotLines("lines", samples.data(), SAMPLE_COUNT, samplesOffset, NULL, FLT_MAX, FLT_MAX, size); });
+    timeFrames("PlotLines(), fixed scale", pushBatch, [&]() { ImGui::PlotLines("lines", samples.data(), SAMPLE_COUNT, samplesOffset, NULL, 0.0f, 100.0f, size); });
+
+    // push() one sample at a time, and in batches of SAMPLES_PER_FRAME
+    const auto singleStart = std::chrono::steady_clock::now();
+    for (int n = 0; n < SAMPLE_COUNT; n++)
+        plot.push(samples[n]);
+    const double singleNs = elapsedUs(singleStart) * 1000.0 / SAMPLE_COUNT;
+    const auto batchStart = std::chrono::steady_clock::now();
+    for (int n = 0; n + SAMPLES_PER_FRAME <= SAMPLE_COUNT; n += SAMPLES_PER_FRAME)
+        plot.push(&samples[n], SAMPLES_PER_FRAME);
+    const double batchNs = elapsedUs(batchStart) * 1000.0 / (SAMPLE_COUNT / SAMPLES_PER_FRAME * SAMPLES_PER_FRAME);
+    printf("push(): %.1f ns per sample, %.1f ns per sample in batches of %d\n", singleNs, batchNs, SAMPLES_PER_FRAME);
+
+    ImGui::DestroyContext();
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+//
+// Host benchmark of ImGuiTableSorter
+// Built and run by bench_imgui.sh. sortIndices() is first checked against std::stable_sort, then timed against it
+// (on a single core machine it is std::stable_sort). Finally a 200k row table is sorted through update() with the
+// compare function capturing its data through a std::shared_ptr, as in the header example: the cost of update() on
+// the UI thread (which does the sorting itself on a single core) and the frames until the sorted order is displayed
+// are reported, and the order is checked against std::stable_sort.
+//
+
+#include "../Include/ImGuiTableSorter.h"
+#include "../Include/ImGui/imgui_internal.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+static const int RUNS = 5;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Stability and edge sizes around the run size, with few and many distinct keys
+static int checkAgainstStableSort(std::mt19937& rng) {
+    static const int SIZES[] = { 0, 1, 5, 100, 4095, 4096, 10000, 65537, 300000 };
+    static const int KEY_RANGES[] = { 3, 1000000 };
+    int mismatches = 0;
+    for (int size : SIZES) {
+        for (int keyRange : KEY_RANGES) {
+            std::vector<int> keys(size);
+            for (int& key : keys)
+                key = (int)(rng() % keyRange);
+            std::vector<int> sorted(size);
+            for (int n = 0; n < size; n++)
+                sorted[n] = n;
+            std::shuffle(sorted.begin(), sorted.end(), rng);
+            std::vector<int> expected = sorted;
+            auto less = [&keys](int lhs, int rhs) { return keys[lhs] < keys[rhs]; };
+            ImGuiTableSorter::sortIndices(sorted, less);
+            std::stable_sort(expected.begin(), expected.end(), less);
+            mismatches += sorted != expected;
+        }
+    }
+    return mismatches;
+}
+
+int main() {
+    std::mt19937 rng(3);
+    printf("cores: %u, pool threads: %d\n", std::thread::hardware_concurrency(), ImGuiWorkerPool::getInstance().getThreadCount());
+    int mismatches = checkAgainstStableSort(rng);
+    printf("%d mismatches against std::stable_sort\n", mismatches);
+
+    static const int ROW_COUNTS[] = { 100000, 1000000 };
+    for (int rowCount : ROW_COUNTS) {
+        std::vector<float> keys(rowCount);
+        for (float& key : keys)
+            key = (float)(rng() % 100000);
+        std::vector<int> identity(rowCount);
+        for (int n = 0; n < rowCount; n++)
+            identity[n] = n;
+        auto less = [&keys](int lhs, int rhs) { return keys[lhs] < keys[rhs]; };
+        double bestParallel = 1e30, bestStable = 1e30;
+        for (int run = 0; run < RUNS; run++) {
+            std::vector<int> rows = identity;
+            auto start = std::chrono::steady_clock::now();
+            ImGuiTableSorter::sortIndices(rows, less);
+            bestParallel = std::min(bestParallel, elapsedMs(start));
+            rows = identity;
+            start = std::chrono::steady_clock::now();
+            std::stable_sort(rows.begin(), rows.end(), less);
+            bestStable = std::min(bestStable, elapsedMs(start));
+        }
+        printf("%7d rows: sortIndices %.2f ms, std::stable_sort %.2f ms (best of %d)\n", rowCount, bestParallel, bestStable, RUNS);
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(800, 600);
+    io.IniFilename = NULL;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    std::shared_ptr<std::vector<int>> values = std::make_shared<std::vector<int>>(200000);
+    for (int& value : *values)
+        value = (int)(rng() % 1000);
+    std::shared_ptr<const std::vector<int>> items = values;
+    {
+        ImGuiTableSorter sorter;
+        int frames = 0;
+        double worstUpdateUs = 0.0;
+        do {
+            io.DeltaTime = 1.0f / 60.0f;
+            ImGui::NewFrame();
+            ImGui::Begin("Bench");
+            if (ImGui::BeginTable("items", 1, ImGuiTableFlags_Sortable)) {
+                ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+                ImGui::TableHeadersRow();
+                auto start = std::chrono::steady_clock::now();
+                sorter.update((int)items->size(), [items](int lhs, int rhs, const ImGuiTableColumnSortSpecs&) {
+                    return (*items)[lhs] < (*items)[rhs] ? -1 : (*items)[lhs] > (*items)[rhs];
+                });
+                worstUpdateUs = std::max(worstUpdateUs, elapsedMs(start) * 1000.0);
+                ImGui::EndTable();
+            }
+            ImGui::End();
+            ImGui::Render();
+            frames++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } while (sorter.isSorting() || frames < 3);
+
+        // Descending, ties in row order
+        std::vector<int> expected(items->size());
+        for (int n = 0; n < (int)expected.size(); n++)
+            expected[n] = n;
+        std::stable_sort(expected.begin(), expected.end(), [&items](int lhs, int rhs) { return (*items)[lhs] > (*items)[rhs]; });
+        int misordered = sorter.getRowCount() == (int)expected.size() ? 0 : 1;
+        for (int n = 0; n < sorter.getRowCount() && !misordered; n++)
+            misordered += sorter.getRow(n) != expected[n];
+        printf("200000 row table: sorted after %d frames, update() worst %.1f us, %d misordered rows\n", frames, worstUpdateUs, misordered);
+        mismatches += misordered;
+    }
+    ImGui::DestroyContext();
+    return mismatches == 0 ? 0 : 1;
+}
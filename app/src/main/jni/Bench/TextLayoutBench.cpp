@@ -0,0 +1,103 @@
+//
+// Host benchmark of the ImFont glyph run cache (ImFontGlyphRunCache in imgui_internal.h)
+// Built and run by ./bench_imgui.sh TextLayout. Each scenario draws 1,000 labels per frame with CalcTextSize() + AddText(), with the cache
+// and with ImFontAtlasFlags_NoGlyphRunCache, alternating RUNS times, and reports the best average time per frame after a warm-up.
+// The vertices of the first frame (cache misses) and of the last frame (cache hits) must match the uncached output exactly,
+// including the labels that are partly or fully outside the clip rectangle.
+//
+
+#include "../Include/ImGui/imgui.h"
+#include "../Include/ImGui/imgui_internal.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+static const int LABEL_COUNT = 1000;
+static const int FRAME_COUNT = 300;
+static const int WARMUP_FRAMES = 50;
+static const int RUNS = 5;
+
+enum Scenario {
+    ScenarioAscii,          // "Player_0042 [42m]", not cached (ASCII fast path)
+    ScenarioLatin1,         // Same with accented Latin-1 characters (UTF-8 decoding)
+    ScenarioWrapped,        // ASCII wrapped at 90 px
+    ScenarioCount
+};
+
+static const char* const SCENARIO_NAMES[ScenarioCount] = { "ascii", "latin1", "wrapped" };
+
+struct FrameOutput {
+    ImVector<ImDrawVert> first;
+    ImVector<ImDrawVert> last;
+    size_t cacheBytes;
+};
+
+static double runScenario(Scenario scenario, bool cache, FrameOutput& output) {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.IniFilename = NULL;
+    if (!cache)
+        io.Fonts->Flags |= ImFontAtlasFlags_NoGlyphRunCache;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    static char labels[LABEL_COUNT][48];
+    for (int i = 0; i < LABEL_COUNT; i++) {
+        if (scenario == ScenarioLatin1)
+            snprintf(labels[i], sizeof(labels[i]), "Jo\xC3\xABl_%04d \xC3\xA0 %dm \xC3\xA9t\xC3\xA9", i, i % 300);
+        else
+            snprintf(labels[i], sizeof(labels[i]), "Player_%04d [%dm] target", i, i % 300);
+    }
+    const float wrapWidth = scenario == ScenarioWrapped ? 90.0f : 0.0f;
+
+    double total = 0.0;
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+        ImFont* font = ImGui::GetFont();
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < LABEL_COUNT; i++) {
+            const ImVec2 size = ImGui::CalcTextSize(labels[i], NULL, false, wrapWidth > 0.0f ? wrapWidth : -1.0f);
+            // One label in 8 starts left of the screen, one in 8 below it: both are clipped
+            const float x = (float)(i % 40) * 48.3f - size.x * 0.5f - (i % 8 == 3 ? 60.0f : 0.0f);
+            const float y = (float)(i / 40) * 40.7f + (i % 8 == 5 ? 1060.0f : 0.0f);
+            drawList->AddText(font, ImGui::GetFontSize(), ImVec2(x, y), IM_COL32(255, 0, 0, 255), labels[i], NULL, wrapWidth);
+        }
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (frame >= WARMUP_FRAMES)
+            total += us;
+        if (frame == 0)
+            output.first = drawList->VtxBuffer;
+        if (frame == FRAME_COUNT - 1) {
+            output.last = drawList->VtxBuffer;
+            output.cacheBytes = io.Fonts->GlyphRunCache ? io.Fonts->GlyphRunCache->BytesUsed : 0;
+        }
+        ImGui::Render();
+    }
+    ImGui::DestroyContext();
+    return total / (FRAME_COUNT - WARMUP_FRAMES);
+}
+
+static bool sameVertices(const ImVector<ImDrawVert>& a, const ImVector<ImDrawVert>& b) {
+    return a.Size == b.Size && memcmp(a.Data, b.Data, (size_t)a.size_in_bytes()) == 0;
+}
+
+int main() {
+    bool identical = true;
+    for (int scenario = 0; scenario < ScenarioCount; scenario++) {
+        FrameOutput uncached, cached;
+        double uncachedUs = 1e30, cachedUs = 1e30;
+        for (int run = 0; run < RUNS; run++) {
+            uncachedUs = ImMin(uncachedUs, runScenario((Scenario)scenario, false, uncached));
+            cachedUs = ImMin(cachedUs, runScenario((Scenario)scenario, true, cached));
+        }
+        const bool same = sameVertices(uncached.first, cached.first) && sameVertices(uncached.last, cached.last);
+        identical &= same;
+        printf("%-8s no cache %7.1f us/frame, cache %7.1f us/frame (%zu KB), %d vertices, %s\n", SCENARIO_NAMES[scenario], uncachedUs, cachedUs,
+               cached.cacheBytes / 1024, cached.last.Size, same ? "identical output" : "OUTPUT DIFFERS");
+    }
+    return identical ? 0 : 1;
+}
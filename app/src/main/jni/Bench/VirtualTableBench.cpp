@@ -0,0 +1,193 @@
+//
+// Host benchmark of ImGuiVirtualTable
+// Built and run by ./bench_imgui.sh VirtualTable. A 100k and a 1M row table with mixed row heights (one row in 5 has two
+// lines) is scrolled to a random position every frame, once in source order and once sorted by the worker. The time of
+// draw() per frame is reported (average, 99th percentile, worst wall clock and CPU time), and every frame the submitted
+// rows are checked: they must be the rows of the view that cover the scroll position, computed by brute force from the
+// row heights.
+//
+
+#include "../Include/ImGuiVirtualTable.h"
+#include "../Include/ImGui/imgui_internal.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <thread>
+
+static const int FRAME_COUNT = 2000;
+static const int WARMUP_FRAMES = 20;
+
+// Two columns, rows with a multiple of 5 as value have a second line. getRowHeight() is exact, so the table's
+// positions can be checked against a brute force prefix sum
+class BenchSource : public ImGuiTableDataSource {
+public:
+    explicit BenchSource(int rowCount) : m_scrollTarget(-1.0f), m_scrollY(0.0f), m_bodyHeight(0.0f) {
+        std::mt19937 rng(7);
+        m_values.resize(rowCount);
+        for (int& value : m_values)
+            value = (int)(rng() % 100000);
+    }
+
+    int getRowCount() const override { return (int)m_values.size(); }
+    int getColumnCount() const override { return 2; }
+
+    void setupColumns() override {
+        ImGui::TableSetupColumn("Row");
+        ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_DefaultSort);
+        // Inside the table's scrolling child window: applied by the next frame
+        if (m_scrollTarget >= 0.0f) {
+            ImGui::SetScrollY(m_scrollTarget);
+            m_scrollTarget = -1.0f;
+        }
+        m_scrollY = ImGui::GetScrollY();
+        m_bodyHeight = ImGui::GetWindowHeight() - rowHeight(-1);
+        m_drawnRows.clear();
+    }
+
+    void drawRow(int row) override {
+        m_drawnRows.push_back(row);
+        ImGui::TableNextColumn();
+        ImGui::Text("%d", row);
+        ImGui::TableNextColumn();
+        ImGui::Text("%d", m_values[row]);
+        if (isTall(row))
+            ImGui::TextUnformatted("second line");
+    }
+
+    float getRowHeight(int row) const override {
+        return isTall(row) ? tallHeight() : 0.0f;
+    }
+
+    int compareRows(int lhs, int rhs, const ImGuiTableColumnSortSpecs&) const override {
+        return m_values[lhs] < m_values[rhs] ? -1 : m_values[lhs] > m_values[rhs];
+    }
+
+    // Height of a source row, -1 for the header row
+    float rowHeight(int row) const {
+        return row >= 0 && isTall(row) ? tallHeight() : ImGui::GetTextLineHeight() + ImGui::GetStyle().CellPadding.y * 2.0f;
+    }
+
+    float m_scrollTarget;
+    float m_scrollY;
+    float m_bodyHeight;
+    std::vector<int> m_drawnRows;
+
+private:
+    bool isTall(int row) const { return m_values[row] % 5 == 0; }
+    static float tallHeight() {
+        return ImGui::GetTextLineHeight() * 2.0f + ImGui::GetStyle().ItemSpacing.y + ImGui::GetStyle().CellPadding.y * 2.0f;
+    }
+
+    std::vector<int> m_values;
+};
+
+static double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// One frame with the table filling a 1280x720 window, returns the time of draw(). 'cpuUs' gets the process CPU time
+// of draw(), which leaves out preemption (the worker thread is idle while scrolling)
+static double drawFrame(ImGuiVirtualTable& table, ImGuiTableFlags flags, double* cpuUs = NULL) {
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Bench", NULL, ImGuiWindowFlags_NoDecoration);
+    const std::clock_t cpuStart = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    table.draw("rows", flags, ImVec2(0.0f, 0.0f));
+    const double us = elapsedUs(start);
+    if (cpuUs)
+        *cpuUs = (double)(std::clock() - cpuStart) * 1e6 / CLOCKS_PER_SEC;
+    ImGui::End();
+    ImGui::Render();
+    return us;
+}
+
+// The submitted rows must be consecutive in the view, start with the row at the scroll position and cover the visible
+// body (the window minus the frozen header row). 'prefix' holds the summed heights of the view's rows
+static bool checkDrawnRows(const BenchSource& source, const std::vector<int>& viewIndex, const std::vector<double>& prefix) {
+    const std::vector<int>& drawn = source.m_drawnRows;
+    if (drawn.empty())
+        return false;
+    const int first = viewIndex[drawn[0]];
+    const int count = (int)drawn.size();
+    for (int n = 1; n < count; n++)
+        if (first + n >= (int)viewIndex.size() || viewIndex[drawn[n]] != first + n)
+            return false;
+    // Positions are compared with a pixel of slack for the header separator and the clip rectangle rounding, plus the
+    // float spacing of ImGui coordinates: past 2^24 px (about 820k rows here) they are 2 px apart
+    const double top = source.m_scrollY;
+    const double bottom = ImMin(top + source.m_bodyHeight, prefix.back());
+    const double slack = 1.5 + bottom * FLT_EPSILON;
+    return prefix[first] <= top + slack && prefix[first + 1] > top - slack && prefix[first + count] >= bottom - slack && prefix[first + count - 1] < bottom + slack;
+}
+
+static int runScenario(int rowCount, bool sorted) {
+    BenchSource source(rowCount);
+    ImGuiVirtualTable table(&source);
+    const ImGuiTableFlags flags = sorted ? ImGuiTableFlags_Sortable : 0;
+
+    // Wait for the sort, the row heights are known without displaying the rows
+    drawFrame(table, flags);
+    while (table.isRebuilding()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        drawFrame(table, flags);
+    }
+    drawFrame(table, flags);
+
+    std::vector<double> prefix(table.getViewRowCount() + 1, 0.0);
+    std::vector<int> viewIndex(rowCount, -1);
+    for (int n = 0; n < table.getViewRowCount(); n++) {
+        prefix[n + 1] = prefix[n] + source.rowHeight(table.getViewRow(n));
+        viewIndex[table.getViewRow(n)] = n;
+    }
+
+    std::mt19937 rng(11);
+    std::vector<double> times;
+    double worstCpuUs = 0.0;
+    int wrongFrames = 0;
+    size_t maxDrawn = 0;
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        source.m_scrollTarget = (float)(rng() % (unsigned int)prefix.back());
+        double cpuUs = 0.0;
+        const double us = drawFrame(table, flags, &cpuUs);
+        if (frame >= WARMUP_FRAMES) {
+            times.push_back(us);
+            worstCpuUs = std::max(worstCpuUs, cpuUs);
+        }
+        wrongFrames += !checkDrawnRows(source, viewIndex, prefix);
+        maxDrawn = std::max(maxDrawn, source.m_drawnRows.size());
+    }
+
+    std::sort(times.begin(), times.end());
+    double total = 0.0;
+    for (double us : times)
+        total += us;
+    printf("%7d rows %-8s draw() avg %5.1f us, p99 %5.1f us, worst %6.1f us (CPU time %5.1f us), up to %zu rows submitted, %d wrong frames\n",
+           rowCount, sorted ? "sorted" : "unsorted", total / times.size(), times[times.size() * 99 / 100], times.back(), worstCpuUs, maxDrawn, wrongFrames);
+    return wrongFrames;
+}
+
+int main() {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.IniFilename = NULL;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    int failures = 0;
+    static const int ROW_COUNTS[] = { 100000, 1000000 };
+    for (int rowCount : ROW_COUNTS) {
+        failures += runScenario(rowCount, false);
+        failures += runScenario(rowCount, true);
+    }
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
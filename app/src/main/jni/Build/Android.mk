@@ -20,11 +20,43 @@ LOCAL_CPPFLAGS += -Wno-error=c++11-narrowing -fms-extensions -fno-rtti -fexcepti
 LOCAL_LDFLAGS += -Wl,--gc-sections, -llog
 LOCAL_ARM_MODE := arm
 
+# CRC32 instructions for ImGui ID hashing (optional in ARMv8.0, present on all arm64 Android SoCs)
+ifeq ($(TARGET_ARCH_ABI),arm64-v8a)
+LOCAL_CFLAGS += -march=armv8-a+crc
+endif
+
+# Lean production build: ndk-build MODMENU_LEAN=1 (or gradle -PmodMenuLean)
+# Drops the demo/metrics windows and file IO, optimizes for size with ThinLTO, folds identical functions and
+# packs the per-frame functions listed in ModMenu.order together
+ifeq ($(MODMENU_LEAN),1)
+LOCAL_CFLAGS += -DIMGUI_DISABLE_DEMO_WINDOWS -DIMGUI_DISABLE_METRICS_WINDOW -DIMGUI_DISABLE_FILE_FUNCTIONS
+LOCAL_CFLAGS += -Oz -flto=thin
+LOCAL_LDFLAGS += -Oz -flto=thin -Wl,--icf=safe -Wl,-O2 -Wl,--pack-dyn-relocs=android
+LOCAL_LDFLAGS += -Wl,--symbol-ordering-file=$(LOCAL_PATH)/ModMenu.order -Wl,--no-warn-symbol-ordering
+endif
+
+# Profile-guided build, driven by build_pgo.sh
+# MODMENU_PGO=generate instruments the code, MODMENU_PGO=use optimizes it with ThinLTO and the merged profile of the
+# ABI being built (pgo/ModMenu-<abi>.profdata, made by running the replay harness)
+MODMENU_PROFILE := $(LOCAL_PATH)/pgo/ModMenu-$(TARGET_ARCH_ABI).profdata
+ifeq ($(MODMENU_PGO),generate)
+LOCAL_CFLAGS += -fprofile-generate
+LOCAL_LDFLAGS += -fprofile-generate
+endif
+ifeq ($(MODMENU_PGO),use)
+ifneq ($(wildcard $(MODMENU_PROFILE)),)
+LOCAL_CFLAGS += -fprofile-use=$(MODMENU_PROFILE) -flto=thin
+LOCAL_LDFLAGS += -flto=thin
+else
+$(warning No profile for $(TARGET_ARCH_ABI), building ModMenu without PGO. Run build_pgo.sh first)
+endif
+endif
+
 LOCAL_STATIC_LIBRARIES := libdobby
 LOCAL_LDLIBS := -lz
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/xdl/include
 
-LOCAL_SRC_FILES := ../Main/Main.cpp \
+MODMENU_SRC_FILES := ../Main/Main.cpp \
                    ../Include/ImGui/backends/imgui_impl_opengl3.cpp \
                    ../Include/ImGui/backends/imgui_impl_android.cpp \
                    ../Include/ImGui/imgui.cpp \
@@ -32,6 +64,16 @@ LOCAL_SRC_FILES := ../Main/Main.cpp \
                    ../Include/ImGui/imgui_demo.cpp \
                    ../Include/ImGui/imgui_tables.cpp \
                    ../Include/ImGui/imgui_widgets.cpp \
+                   ../Include/ImGuiFrameArena.cpp \
+                   ../Include/ImGuiTableSorter.cpp \
+                   ../Include/ImGuiAutocomplete.cpp \
+                   ../Include/ImGuiConfig.cpp \
+                   ../Include/ImGuiConfigJNI.cpp \
+                   ../Include/MonotonicArena.cpp \
+                   ../Include/OffsetDatabase.cpp \
+                   ../Include/ImGuiVirtualTable.cpp \
+                   ../Include/ImGuiStreamingPlot.cpp \
+                   ../Include/ImGuiJniWorker.cpp \
                    ../Include/ImGuiSoftKeyboard.cpp \
                    ../Include/ImGuiSoftKeyboardJNI.cpp \
                    ../Include/ImGuiSoftKeyboardExample.cpp \
@@ -45,10 +87,40 @@ LOCAL_SRC_FILES := ../Main/Main.cpp \
                    ../Include/KittyMemory/MemoryBackup.cpp \
                    ../Include/KittyMemory/KittyUtils.cpp \
 
+LOCAL_SRC_FILES := $(MODMENU_SRC_FILES)
 LOCAL_LDLIBS := -llog -landroid -lz -lEGL -lGLESv3 -lGLESv2
 
 include $(BUILD_SHARED_LIBRARY)
 
+# Replay harness: the ModMenu sources and flags in an executable that runs the frame loop on SoftGL
+# Nothing is defined on top of the ModMenu flags, the sources must preprocess as in libModMenu.so for the profile to
+# match them. The replay driver is the only extra code (its g_modMenuReplay turns init() into a no-op at run time)
+ifeq ($(MODMENU_REPLAY),1)
+MODMENU_CFLAGS := $(LOCAL_CFLAGS)
+MODMENU_CPPFLAGS := $(LOCAL_CPPFLAGS)
+MODMENU_LDFLAGS := $(LOCAL_LDFLAGS)
+MODMENU_C_INCLUDES := $(LOCAL_C_INCLUDES)
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE    := ModMenuReplay
+LOCAL_CFLAGS := $(MODMENU_CFLAGS)
+LOCAL_CPPFLAGS := $(MODMENU_CPPFLAGS)
+LOCAL_LDFLAGS := $(MODMENU_LDFLAGS)
+LOCAL_ARM_MODE := arm
+LOCAL_C_INCLUDES := $(MODMENU_C_INCLUDES)
+LOCAL_STATIC_LIBRARIES := libdobby
+
+# SoftGL defines the GL and EGL entry points, they take precedence over the system libraries
+LOCAL_SRC_FILES := $(MODMENU_SRC_FILES) \
+                   ../Replay/ModMenuReplay.cpp \
+                   ../Replay/SoftGL.cpp \
+
+LOCAL_LDLIBS := -llog -landroid -lz -lEGL -lGLESv3 -lGLESv2
+
+include $(BUILD_EXECUTABLE)
+endif
+
 # Loader
 include $(CLEAR_VARS)
 
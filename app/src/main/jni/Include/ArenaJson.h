@@ -0,0 +1,56 @@
+#pragma once
+
+#include "MonotonicArena.h"
+#include "json/json.hpp"
+#include <cstddef>
+#include <new>
+
+/**
+ * Standard allocator over the current MonotonicArena of the thread (MonotonicArena::Scope)
+ * nlohmann::basic_json and the std containers default-construct their allocators, so the arena cannot be passed in
+ * and is taken from the scope instead. Inside a scope allocate() bumps the arena pointer and deallocate() does nothing
+ * for arena memory. Outside of any scope it behaves like std::allocator.
+ * A value allocated in an arena must be destroyed inside a scope of that arena, before MonotonicArena::reset().
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator() noexcept {}
+    template<typename U> ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        MonotonicArena* arena = MonotonicArena::getCurrent();
+        if (arena)
+            return (T*)arena->allocate(count * sizeof(T), alignof(T));
+        return (T*)::operator new(count * sizeof(T));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        MonotonicArena* arena = MonotonicArena::getCurrent();
+        if (arena && arena->owns(p))
+            return;
+        ::operator delete(p);
+    }
+};
+
+// Stateless, any two allocators can free each other's memory
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return true; }
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return false; }
+
+/**
+ * nlohmann::json whose values, objects, arrays and string objects are allocated with ArenaAllocator
+ * Parsing or copying a document inside a MonotonicArena::Scope costs a few chunk allocations instead of one malloc
+ * per value, and dropping it costs nothing once the arena is reset:
+ *   MonotonicArena::Scope scope(arena);
+ *   ArenaJson json = ArenaJson::parse(begin, end, nullptr, false);
+ *   ...
+ *   json = nullptr;     // Still inside the scope
+ *   arena.reset();
+ * string_t stays std::string (the json.hpp binary readers only build with it): short strings are stored inline in
+ * the arena, longer ones still have a heap buffer.
+ */
+typedef nlohmann::basic_json<std::map, std::vector, std::string, bool, std::int64_t, std::uint64_t, double, ArenaAllocator> ArenaJson;
@@ -12,6 +12,9 @@
 #include "ImGui/backends/imgui_impl_opengl3.h"
 #include "ImGui/backends/imgui_impl_android.h"
 #include "ImGui/backends/android_native_app_glue.h"
+#include "ImGuiFrameArena.h"
+#include "ImGuiSoftKeyboard.h"
+#include "ImGuiConfig.h"
 
 #include "Utils.h"
 #include "Dobby/dobby.h"
@@ -78,6 +81,9 @@ void *initModMenu(void *menu_addr) {
 void setupMenu() {
     if (isInitialized) return;
 
+    // Must be installed before the context allocates anything
+    ImGuiFrameArena::getInstance().install();
+
     auto ctx = ImGui::CreateContext();
     if (!ctx) {
         LOGI(OBFUSCATE("Failed to create context"));
@@ -93,6 +99,13 @@ void setupMenu() {
     ImGui_ImplAndroid_Init();
     ImGui_ImplOpenGL3_Init("#version 300 es");
 
+    // Saved menu values and window layout, written back by ImGuiConfig::update(). Kept in memory only when the app
+    // files directory is unknown (loadJNI() did not run)
+    const std::string configPath = ImGuiConfig::getDefaultPath();
+    if (!configPath.empty()) {
+        ImGuiConfig::getInstance().load(configPath.c_str());
+    }
+
     int systemScale = (1.0 / glWidth) * glWidth;
     ImFontConfig font_cfg;
     font_cfg.SizePixels = systemScale * 22.0f;
@@ -100,6 +113,9 @@ void setupMenu() {
 
     ImGui::GetStyle().ScaleAllSizes(2);
 
+    // The menu never transforms vertices after the fact, shapes outside of the clip rectangle can be dropped early
+    ImGui::GetStyle().CullOffscreenPrimitives = true;
+
     isInitialized = true;
     LOGI("setup done.");
 }
@@ -110,13 +126,25 @@ void internalDrawMenu(int width, int height) {
 
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplAndroid_NewFrame(width, height);
+
+    // Keyboard events queued by the Java UI thread since the last frame
+    if (g_softKeyboard) g_softKeyboard->processInput();
+
     ImGui::NewFrame();
 
     menuAddress();
 
+    // Text and cursor changes of the focused input go to Java once per frame
+    if (g_softKeyboard) g_softKeyboard->update();
+
+    // Changed values are saved by a background thread once they settle
+    ImGuiConfig::getInstance().update();
+
     ImGui::Render();
 
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+    ImGuiFrameArena::getInstance().endFrame();
 }
 
 EGLBoolean swapbuffers_hook(EGLDisplay dpy, EGLSurface surf) {
@@ -5,7 +5,7 @@
 
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
-//  [x] Renderer: Desktop GL only: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [x] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices. GL ES 3.x: base-vertex draws when available, vertex attribute rebasing otherwise.
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -14,6 +14,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-18: OpenGL: GL ES 3.x: Resolve glDrawElementsBaseVertex() at runtime (ES 3.2 core, EXT/OES extensions) and rebase vertex attribute pointers when missing, enabling ImGuiBackendFlags_RendererHasVtxOffset.
 //  2021-08-23: OpenGL: Fixed ES 3.0 shader ("#version 300 es") use normal precision floats to avoid wobbly rendering at HD resolutions.
 //  2021-08-19: OpenGL: Embed and use our own minimal GL loader (imgui_impl_opengl3_loader.h), removing requirement and support for third-party loader.
 //  2021-06-29: Reorganized backend to pull data from a single structure to facilitate usage with multiple-contexts (all g_XXXX access changed to bd->XXXX).
@@ -146,6 +147,14 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
 #endif
 
+// GL ES 3.2 has glDrawElementsBaseVertex(), GL ES 3.0/3.1 may expose it through GL_EXT/GL_OES_draw_elements_base_vertex.
+// The entry point is not in the GLES3 headers, so it is resolved at runtime through EGL.
+#if defined(IMGUI_IMPL_OPENGL_ES3) && defined(__ANDROID__)
+#include <EGL/egl.h>
+#define IMGUI_IMPL_OPENGL_ES3_MAY_HAVE_BASE_VERTEX
+typedef void (GL_APIENTRYP ImGui_ImplOpenGL3_DrawElementsBaseVertexFn)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+#endif
+
 // Desktop GL 3.3+ has glBindSampler()
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
@@ -175,6 +184,9 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          AttribLocationVtxColor;
     unsigned int    VboHandle, ElementsHandle;
     bool            HasClipOrigin;
+#ifdef IMGUI_IMPL_OPENGL_ES3_MAY_HAVE_BASE_VERTEX
+    ImGui_ImplOpenGL3_DrawElementsBaseVertexFn DrawElementsBaseVertex; // NULL when unavailable: ImDrawCmd::VtxOffset is then honored by rebasing vertex attributes
+#endif
 
     ImGui_ImplOpenGL3_Data() { memset(this, 0, sizeof(*this)); }
 };
@@ -227,6 +239,26 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     if (bd->GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
+#ifdef IMGUI_IMPL_OPENGL_ES3_MAY_HAVE_BASE_VERTEX
+    if (bd->GlVersion >= 320)
+        bd->DrawElementsBaseVertex = (ImGui_ImplOpenGL3_DrawElementsBaseVertexFn)eglGetProcAddress("glDrawElementsBaseVertex");
+    if (bd->DrawElementsBaseVertex == NULL)
+    {
+        GLint num_es_extensions = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &num_es_extensions);
+        for (GLint i = 0; i < num_es_extensions && bd->DrawElementsBaseVertex == NULL; i++)
+        {
+            const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if (extension == NULL)
+                continue;
+            if (strcmp(extension, "GL_EXT_draw_elements_base_vertex") == 0)
+                bd->DrawElementsBaseVertex = (ImGui_ImplOpenGL3_DrawElementsBaseVertexFn)eglGetProcAddress("glDrawElementsBaseVertexEXT");
+            else if (strcmp(extension, "GL_OES_draw_elements_base_vertex") == 0)
+                bd->DrawElementsBaseVertex = (ImGui_ImplOpenGL3_DrawElementsBaseVertexFn)eglGetProcAddress("glDrawElementsBaseVertexOES");
+        }
+    }
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;      // Either path honors ImDrawCmd::VtxOffset (only ever non-zero with 16-bit ImDrawIdx).
+#endif
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
     // Note: GLSL version is NOT the same as GL version. Leave this to NULL if unsure.
@@ -287,6 +319,15 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
+// Point vertex attributes at ImDrawVert 'vtx_offset' of the bound VBO. Non-zero offsets emulate base-vertex draws.
+static void ImGui_ImplOpenGL3_SetupVertexAttribs(ImGui_ImplOpenGL3_Data* bd, unsigned int vtx_offset)
+{
+    const size_t vtx_base = (size_t)vtx_offset * sizeof(ImDrawVert);
+    glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_base + IM_OFFSETOF(ImDrawVert, pos)));
+    glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_base + IM_OFFSETOF(ImDrawVert, uv)));
+    glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(vtx_base + IM_OFFSETOF(ImDrawVert, col)));
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -355,9 +396,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glEnableVertexAttribArray(bd->AttribLocationVtxPos);
     glEnableVertexAttribArray(bd->AttribLocationVtxUV);
     glEnableVertexAttribArray(bd->AttribLocationVtxColor);
-    glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+    ImGui_ImplOpenGL3_SetupVertexAttribs(bd, 0);
 }
 
 // OpenGL3 Render function.
@@ -417,6 +456,8 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    const GLenum idx_type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    unsigned int bound_vtx_offset = 0;               // Vertex attribute rebase currently applied (see ImGui_ImplOpenGL3_SetupVertexAttribs)
 
     // Render command lists
     for (int n = 0; n < draw_data->CmdListsCount; n++)
@@ -435,7 +476,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    bound_vtx_offset = 0;
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -454,10 +498,24 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
-                    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
                 else
 #endif
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+#ifdef IMGUI_IMPL_OPENGL_ES3_MAY_HAVE_BASE_VERTEX
+                if (bd->DrawElementsBaseVertex != NULL && pcmd->VtxOffset != 0)
+                    bd->DrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                else
+                {
+                    if (bd->DrawElementsBaseVertex == NULL && pcmd->VtxOffset != bound_vtx_offset)
+                    {
+                        ImGui_ImplOpenGL3_SetupVertexAttribs(bd, pcmd->VtxOffset);
+                        bound_vtx_offset = pcmd->VtxOffset;
+                    }
+                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+                }
+#else
+                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+#endif
             }
         }
     }
@@ -496,6 +554,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
     glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
     (void)bd; // Not all compilation paths use this
+    (void)bound_vtx_offset;
 }
 
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
@@ -48,6 +48,10 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_NEON                                // Disable use of NEON intrinsics even if available
+//#define IMGUI_DISABLE_HW_CRC32                            // Don't hash IDs with ARMv8 CRC32 instructions even if available (__ARM_FEATURE_CRC32). IDs are identical either way.
+//#define IMGUI_USE_CRC32C                                  // Hash IDs with CRC32C using ARMv8 or x86-64 SSE4.2 instructions (required). Faster on x86 but changes every ID value (stored .ini settings, hard-coded IDs).
+//#define IMGUI_DISABLE_STORAGE_HASH_INDEX                  // Keep g.WindowsById, per-window StateStorage and TextScalar() cache maps as sorted vectors instead of enabling ImGuiStorage::SetUseHashIndex() on them.
 
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
@@ -94,7 +98,10 @@
 // Your renderer backend will need to support it (most example renderer backends support both 16/32-bit indices).
 // Another way to allow large meshes while keeping 16-bit indices is to handle ImDrawCmd::VtxOffset in your renderer.
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
-//#define ImDrawIdx unsigned int
+// ModMenu: enabled. GL ES 3.0 accepts GL_UNSIGNED_INT indices natively, so heavy overlays (ESP markers, 100k+ vertices in the
+// background draw list) render as a single upload per draw list without VtxOffset command splitting. Comment out to go back to
+// 16-bit indices, in which case imgui_impl_opengl3.cpp falls back to base-vertex draws or vertex attribute rebasing.
+#define ImDrawIdx unsigned int
 
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;
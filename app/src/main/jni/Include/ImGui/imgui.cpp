@@ -1070,6 +1070,7 @@ ImGuiStyle::ImGuiStyle()
     AntiAliasedLines        = true;             // Enable anti-aliased lines/borders. Disable if you are really tight on CPU/GPU.
     AntiAliasedLinesUseTex  = true;             // Enable anti-aliased lines/borders using textures where possible. Require backend to render with bilinear filtering.
     AntiAliasedFill         = true;             // Enable anti-aliased filled shapes (rounded rectangles, circles, etc.).
+    CullOffscreenPrimitives = false;            // Reject ImDrawList primitives entirely outside of the current clip rectangle before tessellating them. Off by default, vertices may be transformed after the fact.
     CurveTessellationTol    = 1.25f;            // Tessellation tolerance when using PathBezierCurveTo() without a specific number of segments. Decrease for highly tessellated curves (higher quality, more polygons), increase to reduce quality.
     CircleTessellationMaxError = 0.30f;         // Maximum error (in pixels) allowed when using AddCircle()/AddCircleFilled() or drawing rounded corner rectangles with no explicit segment count specified. Decrease for higher quality but more geometry.
 
@@ -1678,6 +1679,223 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS
 
+// Write the decimal digits of 'v' ending at 'buf_end', return the first one
+static char* ImFormatDecimalBackwards(char* buf_end, ImU64 v)
+{
+    do { *--buf_end = (char)('0' + (int)(v % 10)); v /= 10; } while (v != 0);
+    return buf_end;
+}
+
+// "%.Nf" without vsnprintf(). Return -1 when the result may differ from printf: NaN/inf, large values, or when the
+// value is too close to a rounding tie (printf rounds the exact binary value, we only have the rounded product).
+static int ImFormatFixed(char* buf, double v, int precision)
+{
+    static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    ImU64 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    const bool negative = (bits >> 63) != 0; // printf keeps the sign of -0.0 and of negative values rounding to zero
+    const double scaled = (negative ? -v : v) * pow10[precision];
+    if (!(scaled < 4e15))
+        return -1;
+    const double scaled_floor = floor(scaled);
+    const double frac = scaled - scaled_floor;
+    if (fabs(frac - 0.5) <= scaled * 4.5e-16 + 1e-300)
+        return -1;
+    ImU64 n = (ImU64)scaled_floor + (frac > 0.5 ? 1 : 0);
+
+    char tmp[32];
+    char* p = tmp + IM_ARRAYSIZE(tmp);
+    if (precision > 0)
+    {
+        for (int i = 0; i < precision; i++, n /= 10)
+            *--p = (char)('0' + (int)(n % 10));
+        *--p = '.';
+    }
+    p = ImFormatDecimalBackwards(p, n);
+    if (negative)
+        *--p = '-';
+    const int len = (int)(tmp + IM_ARRAYSIZE(tmp) - p);
+    memcpy(buf, p, (size_t)len);
+    return len;
+}
+
+int ImFormatStringFast(char* buf, size_t buf_size, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int w = ImFormatStringFastV(buf, buf_size, fmt, args);
+    va_end(args);
+    return w;
+}
+
+// Formats with one conversion among %d %i %u %x %X %f %.Nf (no flag or width, N <= 9) and any literal text around it are
+// converted here, everything else goes to ImFormatStringV(). Output and return value are identical to ImFormatStringV().
+int ImFormatStringFastV(char* buf, size_t buf_size, const char* fmt, va_list args)
+{
+    const char* spec = strchr(fmt, '%');
+    if (spec == NULL)
+        return ImFormatStringV(buf, buf_size, fmt, args);
+    const char* p = spec + 1;
+    int precision = -1;
+    if (p[0] == '.' && p[1] >= '0' && p[1] <= '9')
+    {
+        precision = p[1] - '0';
+        p += 2;
+    }
+    const char conv = *p;
+    const bool is_int = (conv == 'd' || conv == 'i' || conv == 'u' || conv == 'x' || conv == 'X');
+    if (!(is_int && precision == -1) && conv != 'f')
+        return ImFormatStringV(buf, buf_size, fmt, args);
+    const char* suffix = p + 1;
+    if (strchr(suffix, '%') != NULL)
+        return ImFormatStringV(buf, buf_size, fmt, args);
+
+    char value_buf[32];
+    const char* value = value_buf;
+    int value_len;
+    if (conv == 'f')
+    {
+        const double v = va_arg(args, double);
+        value_len = ImFormatFixed(value_buf, v, precision < 0 ? 6 : precision);
+        if (value_len < 0)
+            return ImFormatString(buf, buf_size, fmt, v);
+    }
+    else
+    {
+        char* value_end = value_buf + IM_ARRAYSIZE(value_buf);
+        char* value_begin;
+        if (conv == 'x' || conv == 'X')
+        {
+            const char* hex_digits = (conv == 'x') ? "0123456789abcdef" : "0123456789ABCDEF";
+            unsigned int v = va_arg(args, unsigned int);
+            value_begin = value_end;
+            do { *--value_begin = hex_digits[v & 0xF]; v >>= 4; } while (v != 0);
+        }
+        else if (conv == 'u')
+        {
+            value_begin = ImFormatDecimalBackwards(value_end, va_arg(args, unsigned int));
+        }
+        else
+        {
+            const int v = va_arg(args, int);
+            value_begin = ImFormatDecimalBackwards(value_end, v < 0 ? (ImU64)(-(ImS64)v) : (ImU64)v);
+            if (v < 0)
+                *--value_begin = '-';
+        }
+        value = value_begin;
+        value_len = (int)(value_end - value_begin);
+    }
+
+    const int prefix_len = (int)(spec - fmt);
+    const int suffix_len = (int)strlen(suffix);
+    const int w = prefix_len + value_len + suffix_len;
+    if (buf == NULL)
+        return w;
+
+    // Truncate like ImFormatStringV()
+    char* out = buf;
+    char* out_end = buf + buf_size - 1;
+    const char* parts[3] = { fmt, value, suffix };
+    const int parts_len[3] = { prefix_len, value_len, suffix_len };
+    for (int n = 0; n < 3 && out < out_end; n++)
+    {
+        const int len = ImMin(parts_len[n], (int)(out_end - out));
+        memcpy(out, parts[n], (size_t)len);
+        out += len;
+    }
+    *out = 0;
+    return (int)(out - buf);
+}
+
+// Hardware CRC32, see IMGUI_USE_CRC32C and IMGUI_DISABLE_HW_CRC32 in imconfig.h.
+// - ARMv8 CRC32 instructions implement the same polynomial as GCrc32LookupTable: IDs are identical to the table code (compatibility mode, default when available).
+// - CRC32C (Castagnoli) is the only polynomial available on x86 (SSE4.2) and is also implemented by ARMv8: IDs are consistent across those platforms but differ from the table code.
+// Both process 8 bytes per instruction. Note that ARMv8.0 leaves CRC32 optional: compile with -march=armv8-a+crc (defines __ARM_FEATURE_CRC32) to enable it.
+#if defined(IMGUI_USE_CRC32C)
+#if defined(__ARM_FEATURE_CRC32) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_acle.h>
+#define IM_CRC32_U8(_CRC, _V)   __crc32cb(_CRC, _V)
+#define IM_CRC32_U64(_CRC, _V)  __crc32cd(_CRC, _V)
+#elif defined(__SSE4_2__) && (defined(__x86_64__) || defined(_M_X64))
+#include <nmmintrin.h>
+#define IM_CRC32_U8(_CRC, _V)   _mm_crc32_u8(_CRC, _V)
+#define IM_CRC32_U64(_CRC, _V)  (ImU32)_mm_crc32_u64(_CRC, _V)
+#else
+#error "IMGUI_USE_CRC32C requires ARMv8 CRC32 (-march=armv8-a+crc) or x86-64 SSE4.2 (-msse4.2) instructions."
+#endif
+#elif defined(__ARM_FEATURE_CRC32) && (defined(__aarch64__) || defined(_M_ARM64)) && !defined(IMGUI_DISABLE_HW_CRC32)
+#include <arm_acle.h>
+#define IM_CRC32_U8(_CRC, _V)   __crc32b(_CRC, _V)
+#define IM_CRC32_U64(_CRC, _V)  __crc32d(_CRC, _V)
+#endif
+
+#ifdef IM_CRC32_U8
+
+// Non-zero if any byte of 'w' equals 'c'
+static inline ImU64 ImHasByte64(ImU64 w, unsigned char c)
+{
+    const ImU64 x = w ^ (0x0101010101010101ULL * c);
+    return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+}
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    ImU32 crc = ~seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 w;
+        memcpy(&w, data, 8);
+        crc = IM_CRC32_U64(crc, w);
+    }
+    while (data_size-- != 0)
+        crc = IM_CRC32_U8(crc, *data++);
+    return ~crc;
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+// Because this syntax is rarely used we are optimizing for the common case.
+// - Blocks of 8 bytes without any '#' are hashed with one instruction, others go through the byte loop with the original ### check.
+// - A zero-terminated string is measured first (strlen is vectorized by the C library) so we never read past its end.
+ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
+{
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    while (data_size != 0)
+    {
+        if (data_size >= 8)
+        {
+            ImU64 w;
+            memcpy(&w, data, 8);
+            if (!ImHasByte64(w, '#'))
+            {
+                crc = IM_CRC32_U64(crc, w);
+                data += 8;
+                data_size -= 8;
+                continue;
+            }
+        }
+        const size_t block_size = ImMin(data_size, (size_t)8);
+        for (size_t n = 0; n < block_size; n++)
+        {
+            unsigned char c = *data++;
+            data_size--;
+            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = IM_CRC32_U8(crc, c);
+        }
+    }
+    return ~crc;
+}
+
+#else
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -1748,6 +1966,8 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+#endif // #ifdef IM_CRC32_U8
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -2128,14 +2348,108 @@ void ImGuiStorage::BuildSortByKey()
         }
     };
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairComparerByID);
+    if (UseHashIndex)
+        BuildHashIndex();
+}
+
+// Linear probing into a table at most half full. Keys are usually CRC32 output already, the mix only helps sequential user keys.
+static inline int StorageHashSlot(ImGuiID key, int mask)
+{
+    ImU32 h = key * 0x9E3779B1u;
+    return (int)((h ^ (h >> 16)) & (ImU32)mask);
+}
+
+// Return the pair for 'key' or NULL, never add/allocate.
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImVector<ImGuiStorage::ImGuiStoragePair>& data = const_cast<ImVector<ImGuiStorage::ImGuiStoragePair>&>(storage->Data);
+    if (storage->UseHashIndex)
+    {
+        if (storage->HashIndex.Size == 0)
+            return NULL;
+        const int mask = storage->HashIndex.Size - 1;
+        for (int slot = StorageHashSlot(key, mask); ; slot = (slot + 1) & mask)
+        {
+            const int idx = storage->HashIndex.Data[slot];
+            if (idx < 0)
+                return NULL;
+            if (data.Data[idx].key == key)
+                return &data.Data[idx];
+        }
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(data, key);
+    if (it == data.end() || it->key != key)
+        return NULL;
+    return it;
+}
+
+// Return the pair for 'key', inserting 'default_pair' if missing.
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& default_pair)
+{
+    const ImGuiID key = default_pair.key;
+    if (storage->UseHashIndex)
+    {
+        if ((storage->Data.Size + 1) * 2 > storage->HashIndex.Size)
+        {
+            if (ImGuiStorage::ImGuiStoragePair* it = StorageFind(storage, key))
+                return it;
+            storage->Data.push_back(default_pair);
+            storage->BuildHashIndex();
+            return &storage->Data.back();
+        }
+        const int mask = storage->HashIndex.Size - 1;
+        int slot = StorageHashSlot(key, mask);
+        for (; storage->HashIndex.Data[slot] >= 0; slot = (slot + 1) & mask)
+            if (storage->Data.Data[storage->HashIndex.Data[slot]].key == key)
+                return &storage->Data.Data[storage->HashIndex.Data[slot]];
+        storage->HashIndex.Data[slot] = storage->Data.Size;
+        storage->Data.push_back(default_pair);
+        return &storage->Data.back();
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+        it = storage->Data.insert(it, default_pair);
+    return it;
+}
+
+// Rebuild HashIndex from Data, sized for at least twice the number of pairs (call after modifying Data directly).
+void ImGuiStorage::BuildHashIndex()
+{
+    int size = 16;
+    while (size < Data.Size * 2)
+        size <<= 1;
+    HashIndex.resize(size);
+    memset(HashIndex.Data, 0xFF, (size_t)HashIndex.size_in_bytes());
+    const int mask = size - 1;
+    for (int n = 0; n < Data.Size; n++)
+    {
+        int slot = StorageHashSlot(Data[n].key, mask);
+        while (HashIndex.Data[slot] >= 0)
+            slot = (slot + 1) & mask;
+        HashIndex.Data[slot] = n;
+    }
+}
+
+void ImGuiStorage::SetUseHashIndex(bool use_hash_index)
+{
+    if (UseHashIndex == use_hash_index)
+        return;
+    UseHashIndex = use_hash_index;
+    if (use_hash_index)
+    {
+        BuildHashIndex();
+    }
+    else
+    {
+        HashIndex.clear();
+        BuildSortByKey();
+    }
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2145,27 +2459,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2175,30 +2482,18 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
 // FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2208,24 +2503,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2238,9 +2521,119 @@ void ImGuiStorage::SetAllInt(int v)
 // [SECTION] ImGuiTextFilter
 //-----------------------------------------------------------------------------
 
+static inline char ImTextFilterFoldChar(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+static inline int ImTextFilterCountTrailingZeros(ImU64 mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Compare a candidate past its first and last characters (already matched)
+static inline bool ImTextFilterMatchAt(const char* text, const char* needle, int needle_len)
+{
+    for (int n = 1; n < needle_len - 1; n++)
+        if (ImTextFilterFoldChar(text[n]) != needle[n])
+            return false;
+    return true;
+}
+
+// Case insensitive (ASCII, like ImStristr) search of a lowercase needle.
+// Candidates are the positions where both the first and the last needle characters match, tested 16 at a time.
+static bool ImTextFilterFind(const char* text, const char* text_end, const char* needle, int needle_len)
+{
+    if (text_end - text < needle_len)
+        return false;
+    const char* last = text_end - needle_len; // Last possible start
+    const char first_lo = needle[0];
+    const char first_up = (first_lo >= 'a' && first_lo <= 'z') ? (char)(first_lo - ('a' - 'A')) : first_lo;
+    const char last_lo = needle[needle_len - 1];
+    const char last_up = (last_lo >= 'a' && last_lo <= 'z') ? (char)(last_lo - ('a' - 'A')) : last_lo;
+    const char* p = text;
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v_first_lo = _mm_set1_epi8(first_lo), v_first_up = _mm_set1_epi8(first_up);
+    const __m128i v_last_lo = _mm_set1_epi8(last_lo), v_last_up = _mm_set1_epi8(last_up);
+    for (; p + 16 <= last + 1; p += 16)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)p);
+        const __m128i b = _mm_loadu_si128((const __m128i*)(p + needle_len - 1));
+        const __m128i eq_first = _mm_or_si128(_mm_cmpeq_epi8(a, v_first_lo), _mm_cmpeq_epi8(a, v_first_up));
+        const __m128i eq_last = _mm_or_si128(_mm_cmpeq_epi8(b, v_last_lo), _mm_cmpeq_epi8(b, v_last_up));
+        ImU64 mask = (ImU64)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+        for (; mask != 0; mask &= mask - 1)
+            if (ImTextFilterMatchAt(p + ImTextFilterCountTrailingZeros(mask), needle, needle_len))
+                return true;
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    const uint8x16_t v_first_lo = vdupq_n_u8((uint8_t)first_lo), v_first_up = vdupq_n_u8((uint8_t)first_up);
+    const uint8x16_t v_last_lo = vdupq_n_u8((uint8_t)last_lo), v_last_up = vdupq_n_u8((uint8_t)last_up);
+    for (; p + 16 <= last + 1; p += 16)
+    {
+        const uint8x16_t a = vld1q_u8((const uint8_t*)p);
+        const uint8x16_t b = vld1q_u8((const uint8_t*)(p + needle_len - 1));
+        const uint8x16_t eq_first = vorrq_u8(vceqq_u8(a, v_first_lo), vceqq_u8(a, v_first_up));
+        const uint8x16_t eq_last = vorrq_u8(vceqq_u8(b, v_last_lo), vceqq_u8(b, v_last_up));
+        // Narrow to 4 bits per byte, as NEON has no movemask
+        ImU64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vandq_u8(eq_first, eq_last)), 4)), 0);
+        for (; mask != 0; mask &= ~((ImU64)0xF << (ImTextFilterCountTrailingZeros(mask) & ~3)))
+            if (ImTextFilterMatchAt(p + (ImTextFilterCountTrailingZeros(mask) >> 2), needle, needle_len))
+                return true;
+    }
+#endif
+    for (; p <= last; p++)
+        if ((p[0] == first_lo || p[0] == first_up) && (p[needle_len - 1] == last_lo || p[needle_len - 1] == last_up) && ImTextFilterMatchAt(p, needle, needle_len))
+            return true;
+    return false;
+}
+
+static bool ImTextFilterTermEquals(const ImGuiTextFilter::ImGuiTextTerm& a, const char* a_buf, const ImGuiTextFilter::ImGuiTextTerm& b, const char* b_buf)
+{
+    return a.Exclude == b.Exclude && a.Len == b.Len && memcmp(a_buf + a.Offset, b_buf + b.Offset, (size_t)a.Len) == 0;
+}
+
+// Whether every text passing 'terms' also passed 'prev_terms', given that the first exclusion/inclusion found decides:
+// same terms except the last inclusion which may only get longer (contains the previous needle), then any number of new exclusions.
+static bool ImTextFilterIsRefinement(const ImVector<ImGuiTextFilter::ImGuiTextTerm>& prev_terms, const char* prev_buf, const ImVector<ImGuiTextFilter::ImGuiTextTerm>& terms, const char* buf)
+{
+    if (prev_terms.Size == 0)
+        return true;
+    if (terms.Size < prev_terms.Size)
+        return false;
+    for (int i = 0; i < prev_terms.Size - 1; i++)
+        if (!ImTextFilterTermEquals(prev_terms[i], prev_buf, terms[i], buf))
+            return false;
+
+    const ImGuiTextFilter::ImGuiTextTerm& prev_last = prev_terms.back();
+    const ImGuiTextFilter::ImGuiTextTerm& last = terms[prev_terms.Size - 1];
+    if (prev_last.Exclude)
+    {
+        if (!ImTextFilterTermEquals(prev_last, prev_buf, last, buf))
+            return false;
+    }
+    else
+    {
+        if (last.Exclude || !ImTextFilterFind(buf + last.Offset, buf + last.Offset + last.Len, prev_buf + prev_last.Offset, prev_last.Len))
+            return false;
+    }
+    for (int i = prev_terms.Size; i < terms.Size; i++)
+        if (!terms[i].Exclude)
+            return false;
+    return true;
+}
+
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
 {
+    BuildCount = 0;
+    Refined = false;
     if (default_filter)
     {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
@@ -2300,8 +2693,34 @@ void ImGuiTextFilter::Build()
         if (Filters[i].b[0] != '-')
             CountGrep += 1;
     }
+
+    // Compile the non empty filters into lowercase needles. A lone '-' never matches anything (see ImStristr) so it is dropped.
+    ImVector<ImGuiTextTerm> prev_terms;
+    prev_terms.swap(Terms);
+    char prev_folded[IM_ARRAYSIZE(FoldedBuf)];
+    memcpy(prev_folded, FoldedBuf, sizeof(FoldedBuf));
+    int folded_len = 0;
+    for (int i = 0; i != Filters.Size; i++)
+    {
+        const ImGuiTextRange& f = Filters[i];
+        if (f.empty())
+            continue;
+        ImGuiTextTerm term;
+        term.Exclude = (f.b[0] == '-');
+        const char* b = term.Exclude ? f.b + 1 : f.b;
+        if (b == f.e)
+            continue;
+        term.Offset = folded_len;
+        term.Len = (int)(f.e - b);
+        for (const char* c = b; c < f.e; c++)
+            FoldedBuf[folded_len++] = ImTextFilterFoldChar(*c);
+        Terms.push_back(term);
+    }
+    Refined = (BuildCount > 0) && ImTextFilterIsRefinement(prev_terms, prev_folded, Terms, FoldedBuf);
+    BuildCount++;
 }
 
+// Same semantics as ImStristr() on each filter in order: the first exclusion or inclusion found decides.
 bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 {
     if (Filters.empty())
@@ -2309,24 +2728,14 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
     if (text == NULL)
         text = "";
+    if (text_end == NULL)
+        text_end = text + strlen(text);
 
-    for (int i = 0; i != Filters.Size; i++)
+    for (int i = 0; i != Terms.Size; i++)
     {
-        const ImGuiTextRange& f = Filters[i];
-        if (f.empty())
-            continue;
-        if (f.b[0] == '-')
-        {
-            // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
-                return false;
-        }
-        else
-        {
-            // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
-                return true;
-        }
+        const ImGuiTextTerm& term = Terms[i];
+        if (ImTextFilterFind(text, text_end, FoldedBuf + term.Offset, term.Len))
+            return !term.Exclude; // Subtract or grep
     }
 
     // Implicit * grep
@@ -2336,6 +2745,32 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+void ImGuiTextFilter::FilterList(ImVector<int>* matches, int* matches_build_count, int items_count, const char* (*items_getter)(void* user_data, int idx), void* user_data) const
+{
+    if (*matches_build_count == BuildCount)
+        return;
+    if (*matches_build_count == BuildCount - 1 && Refined)
+    {
+        // Every item passing the new query passed the previous one
+        int out_count = 0;
+        for (int n = 0; n < matches->Size; n++)
+        {
+            const int idx = (*matches)[n];
+            if (idx < items_count && PassFilter(items_getter(user_data, idx)))
+                (*matches)[out_count++] = idx;
+        }
+        matches->resize(out_count);
+    }
+    else
+    {
+        matches->resize(0);
+        for (int idx = 0; idx < items_count; idx++)
+            if (PassFilter(items_getter(user_data, idx)))
+                matches->push_back(idx);
+    }
+    *matches_build_count = BuildCount;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -3228,6 +3663,10 @@ void ImGui::RenderMouseCursor(ImVec2 base_pos, float base_scale, ImGuiMouseCurso
 ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name) : DrawListInst(NULL)
 {
     memset(this, 0, sizeof(*this));
+#ifndef IMGUI_DISABLE_STORAGE_HASH_INDEX
+    StateStorage.UseHashIndex = true;
+    TextValueCacheMap.UseHashIndex = true;
+#endif
     Name = ImStrdup(name);
     NameBufLen = (int)strlen(name) + 1;
     ID = ImHashStr(name);
@@ -3257,10 +3696,18 @@ ImGuiWindow::~ImGuiWindow()
 
 ImGuiID ImGuiWindow::GetID(const char* str, const char* str_end)
 {
+    ImGuiContext& g = *GImGui;
+#ifdef IMGUI_HAS_STATIC_ID
+    if (g.NextItemStaticID != NULL && g.NextItemStaticID->Label == str && str_end == NULL)
+    {
+        ImGuiStaticID* static_id = g.NextItemStaticID;
+        g.NextItemStaticID = NULL;
+        return GetID(*static_id);
+    }
+#endif
     ImGuiID seed = IDStack.back();
     ImGuiID id = ImHashStr(str, str_end ? (str_end - str) : 0, seed);
     ImGui::KeepAliveID(id);
-    ImGuiContext& g = *GImGui;
     if (g.DebugHookIdInfo == id)
         ImGui::DebugHookIdInfo(id, ImGuiDataType_String, str, str_end);
     return id;
@@ -3318,6 +3765,42 @@ ImGuiID ImGuiWindow::GetIDNoKeepAlive(int n)
     return id;
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+ImGuiID ImGuiWindow::GetID(ImGuiStaticID& static_id)
+{
+    ImGuiID id = GetIDNoKeepAlive(static_id);
+    ImGui::KeepAliveID(id);
+    return id;
+}
+
+ImGuiID ImGuiWindow::GetIDNoKeepAlive(ImGuiStaticID& static_id)
+{
+    ImGuiID seed = IDStack.back();
+    ImGuiID id = static_id.GetID(seed);
+    ImGuiContext& g = *GImGui;
+    if (g.DebugHookIdInfo == id)
+        ImGui::DebugHookIdInfo(id, ImGuiDataType_String, static_id.Label, NULL);
+    return id;
+}
+
+// Apply 'seed' to the precomputed hash: multiply it by SeedMul modulo the CRC polynomial (reflected bit order), see multmodp() in zlib.
+ImGuiID ImGuiStaticID::CalcID(ImGuiID seed) const
+{
+    ImU32 a = SeedMul, b = seed, product = 0;
+    for (ImU32 m = 0x80000000u; m != 0; m >>= 1)
+    {
+        if (a & m)
+        {
+            product ^= b;
+            if ((a & (m - 1)) == 0)
+                break;
+        }
+        b = (b & 1) ? (b >> 1) ^ IM_HASH_CRC32_POLY : (b >> 1);
+    }
+    return product ^ Hash;
+}
+#endif
+
 // This is only used in rare/specific situations to manufacture an ID out of nowhere.
 ImGuiID ImGuiWindow::GetIDFromRectangle(const ImRect& r_abs)
 {
@@ -3359,6 +3842,8 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
+    window->TextValueCache.clear();
+    window->TextValueCacheMap.Clear();
 }
 
 void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
@@ -4297,6 +4782,8 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
+    if (g.Style.CullOffscreenPrimitives)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_CullOffscreen;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
 
@@ -4920,7 +5407,7 @@ void ImGui::Render()
         RenderMouseCursor(g.IO.MousePos, g.Style.MouseCursorScale, g.MouseCursor, IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
 
     // Setup ImDrawData structures for end-user
-    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
+    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsRenderCulledPrimitives = 0;
     for (int n = 0; n < g.Viewports.Size; n++)
     {
         ImGuiViewportP* viewport = g.Viewports[n];
@@ -4934,6 +5421,8 @@ void ImGui::Render()
         ImDrawData* draw_data = &viewport->DrawDataP;
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
+        for (int draw_list_n = 0; draw_list_n < draw_data->CmdListsCount; draw_list_n++)
+            g.IO.MetricsRenderCulledPrimitives += draw_data->CmdLists[draw_list_n]->_CulledPrimCount;
     }
 
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
@@ -7436,6 +7925,16 @@ void ImGui::PushID(int int_id)
     window->IDStack.push_back(id);
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+void ImGui::PushID(ImGuiStaticID& static_id)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiID id = window->GetIDNoKeepAlive(static_id);
+    window->IDStack.push_back(id);
+}
+#endif
+
 // Push a given id value ignoring the ID stack as a seed.
 void ImGui::PushOverrideID(ImGuiID id)
 {
@@ -7484,6 +7983,14 @@ ImGuiID ImGui::GetID(const void* ptr_id)
     return window->GetID(ptr_id);
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+ImGuiID ImGui::GetID(ImGuiStaticID& static_id)
+{
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    return window->GetID(static_id);
+}
+#endif
+
 bool ImGui::IsRectVisible(const ImVec2& size)
 {
     ImGuiWindow* window = GImGui->CurrentWindow;
@@ -12122,6 +12629,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Dear ImGui %s", GetVersion());
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+    Text("%d primitives culled on CPU", io.MetricsRenderCulledPrimitives);
     Text("%d visible windows, %d active allocations", io.MetricsRenderWindows, io.MetricsActiveAllocations);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
@@ -68,6 +68,9 @@ Index of this file:
 #define IMGUI_VERSION_NUM           18707
 #define IMGUI_CHECKVERSION()        ImGui::DebugCheckVersionAndDataLayout(IMGUI_VERSION, sizeof(ImGuiIO), sizeof(ImGuiStyle), sizeof(ImVec2), sizeof(ImVec4), sizeof(ImDrawVert), sizeof(ImDrawIdx))
 #define IMGUI_HAS_TABLE
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define IMGUI_HAS_STATIC_ID                                                     // ImGuiStaticID needs C++14 constexpr (loops in constexpr functions)
+#endif
 
 // Define attributes of all API symbols declarations (e.g. for DLL under Windows)
 // IMGUI_API is used for core imgui functions, IMGUI_IMPL_API is used for the default backends files (imgui_impl_xxx.h)
@@ -143,6 +146,7 @@ struct ImFontAtlas;                 // Runtime data for multiple fonts, bake mul
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
+struct ImFontGlyphRunCache;         // Laid out glyph quads and text sizes of recently used strings (see imgui_internal.h)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
@@ -154,6 +158,7 @@ struct ImGuiOnceUponAFrame;         // Helper for running a block of code not mo
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiPlatformImeData;        // Platform IME data for io.SetPlatformImeDataFn() function.
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
+struct ImGuiStaticID;               // Helper: label with its ID hash precomputed at compile time (C++14)
 struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often handling sort specs for a single column, occasionally more)
@@ -466,10 +471,16 @@ namespace ImGui
     IMGUI_API void          PushID(const char* str_id_begin, const char* str_id_end);       // push string into the ID stack (will hash string).
     IMGUI_API void          PushID(const void* ptr_id);                                     // push pointer into the ID stack (will hash pointer).
     IMGUI_API void          PushID(int int_id);                                             // push integer into the ID stack (will hash integer).
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API void          PushID(ImGuiStaticID& static_id);                               // push pre-hashed string into the ID stack (no hashing once the seed is cached). See IM_STATIC_ID().
+#endif
     IMGUI_API void          PopID();                                                        // pop from the ID stack.
     IMGUI_API ImGuiID       GetID(const char* str_id);                                      // calculate unique ID (hash of whole ID stack + given parameter). e.g. if you want to query into ImGuiStorage yourself
     IMGUI_API ImGuiID       GetID(const char* str_id_begin, const char* str_id_end);
     IMGUI_API ImGuiID       GetID(const void* ptr_id);
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API ImGuiID       GetID(ImGuiStaticID& static_id);
+#endif
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
@@ -485,17 +496,29 @@ namespace ImGui
     IMGUI_API void          LabelTextV(const char* label, const char* fmt, va_list args)    IM_FMTLIST(2);
     IMGUI_API void          BulletText(const char* fmt, ...)                                IM_FMTARGS(1); // shortcut for Bullet()+Text()
     IMGUI_API void          BulletTextV(const char* fmt, va_list args)                      IM_FMTLIST(1);
+    IMGUI_API void          TextScalar(ImGuiDataType data_type, const void* p_data, const char* format = NULL);                     // same as Text(format, *p_data), but the formatted text and its size are kept and reused while the value doesn't change (value-watch panels). format = NULL uses the data type default.
+    IMGUI_API void          LabelTextScalar(const char* label, ImGuiDataType data_type, const void* p_data, const char* format = NULL); // same as LabelText(label, format, *p_data), cached the same way. Values are identified by the ID stack, format and p_data: no PushID() needed in loops.
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API void          TextScalar(ImGuiDataType data_type, const void* p_data, ImGuiStaticID& format);                         // format pre-hashed with IM_STATIC_ID("..."): the lookup doesn't hash the format string every call
+    IMGUI_API void          LabelTextScalar(const char* label, ImGuiDataType data_type, const void* p_data, ImGuiStaticID& format);
+#endif
 
     // Widgets: Main
     // - Most widgets return true when the value has been changed or when pressed/selected
     // - You may also use one of the many IsItemXXX functions (e.g. IsItemActive, IsItemHovered, etc.) to query widget state.
     IMGUI_API bool          Button(const char* label, const ImVec2& size = ImVec2(0, 0));   // button
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API bool          Button(ImGuiStaticID& label, const ImVec2& size = ImVec2(0, 0));
+#endif
     IMGUI_API bool          SmallButton(const char* label);                                 // button with FramePadding=(0,0) to easily embed within text
     IMGUI_API bool          InvisibleButton(const char* str_id, const ImVec2& size, ImGuiButtonFlags flags = 0); // flexible button behavior without the visuals, frequently useful to build custom behaviors using the public api (along with IsItemActive, IsItemHovered, etc.)
     IMGUI_API bool          ArrowButton(const char* str_id, ImGuiDir dir);                  // square button with an arrow shape
     IMGUI_API void          Image(ImTextureID user_texture_id, const ImVec2& size, const ImVec2& uv0 = ImVec2(0, 0), const ImVec2& uv1 = ImVec2(1,1), const ImVec4& tint_col = ImVec4(1,1,1,1), const ImVec4& border_col = ImVec4(0,0,0,0));
     IMGUI_API bool          ImageButton(ImTextureID user_texture_id, const ImVec2& size, const ImVec2& uv0 = ImVec2(0, 0),  const ImVec2& uv1 = ImVec2(1,1), int frame_padding = -1, const ImVec4& bg_col = ImVec4(0,0,0,0), const ImVec4& tint_col = ImVec4(1,1,1,1));    // <0 frame_padding uses default frame padding settings. 0 for no padding
     IMGUI_API bool          Checkbox(const char* label, bool* v);
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API bool          Checkbox(ImGuiStaticID& label, bool* v);
+#endif
     IMGUI_API bool          CheckboxFlags(const char* label, int* flags, int flags_value);
     IMGUI_API bool          CheckboxFlags(const char* label, unsigned int* flags, unsigned int flags_value);
     IMGUI_API bool          RadioButton(const char* label, bool active);                    // use with e.g. if (RadioButton("one", my_value==1)) { my_value = 1; }
@@ -544,11 +567,17 @@ namespace ImGui
     // - Legacy: Pre-1.78 there are SliderXXX() function signatures that takes a final `float power=1.0f' argument instead of the `ImGuiSliderFlags flags=0' argument.
     //   If you get a warning converting a float to ImGuiSliderFlags, read https://github.com/ocornut/imgui/issues/3361
     IMGUI_API bool          SliderFloat(const char* label, float* v, float v_min, float v_max, const char* format = "%.3f", ImGuiSliderFlags flags = 0);     // adjust format to decorate the value with a prefix or a suffix for in-slider labels or unit display.
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API bool          SliderFloat(ImGuiStaticID& label, float* v, float v_min, float v_max, const char* format = "%.3f", ImGuiSliderFlags flags = 0);
+#endif
     IMGUI_API bool          SliderFloat2(const char* label, float v[2], float v_min, float v_max, const char* format = "%.3f", ImGuiSliderFlags flags = 0);
     IMGUI_API bool          SliderFloat3(const char* label, float v[3], float v_min, float v_max, const char* format = "%.3f", ImGuiSliderFlags flags = 0);
     IMGUI_API bool          SliderFloat4(const char* label, float v[4], float v_min, float v_max, const char* format = "%.3f", ImGuiSliderFlags flags = 0);
     IMGUI_API bool          SliderAngle(const char* label, float* v_rad, float v_degrees_min = -360.0f, float v_degrees_max = +360.0f, const char* format = "%.0f deg", ImGuiSliderFlags flags = 0);
     IMGUI_API bool          SliderInt(const char* label, int* v, int v_min, int v_max, const char* format = "%d", ImGuiSliderFlags flags = 0);
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API bool          SliderInt(ImGuiStaticID& label, int* v, int v_min, int v_max, const char* format = "%d", ImGuiSliderFlags flags = 0);
+#endif
     IMGUI_API bool          SliderInt2(const char* label, int v[2], int v_min, int v_max, const char* format = "%d", ImGuiSliderFlags flags = 0);
     IMGUI_API bool          SliderInt3(const char* label, int v[3], int v_min, int v_max, const char* format = "%d", ImGuiSliderFlags flags = 0);
     IMGUI_API bool          SliderInt4(const char* label, int v[4], int v_min, int v_max, const char* format = "%d", ImGuiSliderFlags flags = 0);
@@ -603,6 +632,9 @@ namespace ImGui
     IMGUI_API void          TreePop();                                                          // ~ Unindent()+PopId()
     IMGUI_API float         GetTreeNodeToLabelSpacing();                                        // horizontal distance preceding label when using TreeNode*() or Bullet() == (g.FontSize + style.FramePadding.x*2) for a regular unframed TreeNode
     IMGUI_API bool          CollapsingHeader(const char* label, ImGuiTreeNodeFlags flags = 0);  // if returning 'true' the header is open. doesn't indent nor push on ID stack. user doesn't have to call TreePop().
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API bool          CollapsingHeader(ImGuiStaticID& label, ImGuiTreeNodeFlags flags = 0);
+#endif
     IMGUI_API bool          CollapsingHeader(const char* label, bool* p_visible, ImGuiTreeNodeFlags flags = 0); // when 'p_visible != NULL': if '*p_visible==true' display an additional small close button on upper right of the header which will set the bool to false when clicked, if '*p_visible==false' don't display the header.
     IMGUI_API void          SetNextItemOpen(bool is_open, ImGuiCond cond = 0);                  // set next TreeNode/CollapsingHeader open state.
 
@@ -611,6 +643,9 @@ namespace ImGui
     // - Neighbors selectable extend their highlight bounds in order to leave no gap between them. This is so a series of selected Selectable appear contiguous.
     IMGUI_API bool          Selectable(const char* label, bool selected = false, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0)); // "bool selected" carry the selection state (read-only). Selectable() is clicked is returns true so you can modify your selection state. size.x==0.0: use remaining width, size.x>0.0: specify width. size.y==0.0: use label height, size.y>0.0: specify height
     IMGUI_API bool          Selectable(const char* label, bool* p_selected, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0));      // "bool* p_selected" point to the selection state (read-write), as a convenient helper.
+#ifdef IMGUI_HAS_STATIC_ID
+    IMGUI_API bool          Selectable(ImGuiStaticID& label, bool selected = false, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0));
+#endif
 
     // Widgets: List Boxes
     // - This is essentially a thin wrapper to using BeginChild/EndChild with some stylistic changes.
@@ -1874,6 +1909,7 @@ struct ImGuiStyle
     bool        AntiAliasedLines;           // Enable anti-aliased lines/borders. Disable if you are really tight on CPU/GPU. Latched at the beginning of the frame (copied to ImDrawList).
     bool        AntiAliasedLinesUseTex;     // Enable anti-aliased lines/borders using textures where possible. Require backend to render with bilinear filtering. Latched at the beginning of the frame (copied to ImDrawList).
     bool        AntiAliasedFill;            // Enable anti-aliased edges around filled shapes (rounded rectangles, circles, etc.). Disable if you are really tight on CPU/GPU. Latched at the beginning of the frame (copied to ImDrawList).
+    bool        CullOffscreenPrimitives;    // Reject ImDrawList primitives entirely outside of the current clip rectangle before tessellating them. Disable if you transform vertices after the fact without transforming ClipRect. Latched at the beginning of the frame (copied to ImDrawList).
     float       CurveTessellationTol;       // Tessellation tolerance when using PathBezierCurveTo() without a specific number of segments. Decrease for highly tessellated curves (higher quality, more polygons), increase to reduce quality.
     float       CircleTessellationMaxError; // Maximum error (in pixels) allowed when using AddCircle()/AddCircleFilled() or drawing rounded corner rectangles with no explicit segment count specified. Decrease for higher quality but more geometry.
     ImVec4      Colors[ImGuiCol_COUNT];
@@ -1997,6 +2033,7 @@ struct ImGuiIO
     float       Framerate;                          // Rough estimate of application framerate, in frame per second. Solely for convenience. Rolling average estimation based on io.DeltaTime over 120 frames.
     int         MetricsRenderVertices;              // Vertices output during last call to Render()
     int         MetricsRenderIndices;               // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderCulledPrimitives;      // Primitives rejected by ImDrawListFlags_CullOffscreen in draw lists output during last call to Render()
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
     int         MetricsActiveAllocations;           // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
@@ -2174,7 +2211,74 @@ struct ImGuiOnceUponAFrame
     operator bool() const { int current_frame = ImGui::GetFrameCount(); if (RefFrame == current_frame) return false; RefFrame = current_frame; return true; }
 };
 
+#ifdef IMGUI_HAS_STATIC_ID
+
+// Reflected CRC polynomial used by ImHashStr(), see IMGUI_USE_CRC32C in imconfig.h
+#ifdef IMGUI_USE_CRC32C
+#define IM_HASH_CRC32_POLY  0x82F63B78u
+#else
+#define IM_HASH_CRC32_POLY  0xEDB88320u
+#endif
+
+// Compile-time equivalent of ImHashStr(str, 0, seed), including the "###" reset.
+constexpr ImGuiID ImHashStrConst(const char* str, ImU32 seed = 0)
+{
+    ImU32 crc = ~seed;
+    for (const char* p = str; *p; p++)
+    {
+        if (p[0] == '#' && p[1] == '#' && p[2] == '#')
+            crc = ~seed;
+        crc ^= (unsigned char)*p;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (IM_HASH_CRC32_POLY & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+// Helper: Label with its ID hash precomputed at compile time.
+// Widgets taking an ImGuiStaticID display Label as usual but don't hash it: the ID stack seed is applied with one multiplication in
+// the CRC field (CRC is linear: ImHashStr(s, seed) == ImHashStr(s, 0) ^ x^(8*len(s)) * seed, as in zlib's crc32_combine()),
+// and the last (seed, id) pair is cached, so steady state frames only compare the seed. IDs are identical to the 'const char*' versions.
+// Usage:
+//   if (ImGui::Checkbox(IM_STATIC_ID("God Mode"), &god_mode)) {...}    // One static instance per call site
+//   static ImGuiStaticID s_speed_id("Speed##player");                  // Or declare your own
+//   ImGui::SliderFloat(s_speed_id, &speed, 0.0f, 10.0f);
+struct ImGuiStaticID
+{
+    const char*         Label;          // Label passed to the widget, displayed up to "##" as usual
+    ImGuiID             Hash;           // == ImHashStr(Label, 0, 0)
+    ImU32               SeedMul;        // == x^(8*n) mod P, where n is the number of hashed bytes (from the last "###" if any)
+    ImGuiID             CachedSeed;
+    ImGuiID             CachedID;
+
+    constexpr ImGuiStaticID(const char* label) : Label(label), Hash(ImHashStrConst(label)), SeedMul(CalcSeedMul(label)), CachedSeed(0), CachedID(0) {}
+    ImGuiID             GetID(ImGuiID seed) { if (CachedID == 0 || CachedSeed != seed) { CachedSeed = seed; CachedID = CalcID(seed); } return CachedID; }
+    IMGUI_API ImGuiID   CalcID(ImGuiID seed) const;
+
+    static constexpr ImU32 CalcSeedMul(const char* label)
+    {
+        const char* hashed = label;
+        const char* p = label;
+        for (; *p; p++)
+            if (p[0] == '#' && p[1] == '#' && p[2] == '#')
+                hashed = p;
+        ImU32 mul = 0x80000000u; // x^0 (reflected)
+        for (const char* q = hashed; q < p; q++)
+            for (int bit = 0; bit < 8; bit++)
+                mul = (mul >> 1) ^ (IM_HASH_CRC32_POLY & (0u - (mul & 1u)));
+        return mul;
+    }
+};
+
+// One constant-initialized ImGuiStaticID per call site. String literals only: the "" _LABEL "" concatenation fails to compile for a
+// 'const char*' variable, whose first value would otherwise be cached forever by the static (declare your own ImGuiStaticID instead).
+#define IM_STATIC_ID(_LABEL)    ([]() -> ImGuiStaticID& { static ImGuiStaticID s_static_id("" _LABEL ""); return s_static_id; }())
+
+#endif // #ifdef IMGUI_HAS_STATIC_ID
+
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
+// Build() compiles the terms into case folded needles, PassFilter() then scans 16 bytes at a time (SSE2/NEON) for positions matching a needle's first and last characters.
+// To filter a large list, FilterList() keeps the indices of the matching items and only re-tests those when the query was refined (e.g. typing more characters).
 struct ImGuiTextFilter
 {
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
@@ -2184,6 +2288,10 @@ struct ImGuiTextFilter
     void                Clear()          { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
 
+    // Update 'matches' (indices of the items passing the filter) if needed, call every frame. Initialize *matches_build_count to -1, set it back to -1 when the items change.
+    // After a refinement of the previous query only the previous matches are re-tested, otherwise all 'items_count' items.
+    IMGUI_API void      FilterList(ImVector<int>* matches, int* matches_build_count, int items_count, const char* (*items_getter)(void* user_data, int idx), void* user_data) const;
+
     // [Internal]
     struct ImGuiTextRange
     {
@@ -2195,9 +2303,19 @@ struct ImGuiTextFilter
         bool            empty() const                   { return b == e; }
         IMGUI_API void  split(char separator, ImVector<ImGuiTextRange>* out) const;
     };
+    struct ImGuiTextTerm
+    {
+        int             Offset;         // Needle in FoldedBuf
+        int             Len;
+        bool            Exclude;
+    };
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+    ImVector<ImGuiTextTerm> Terms;          // Non empty filters, in order
+    char                    FoldedBuf[256]; // Lowercase needles
+    int                     BuildCount;
+    bool                    Refined;        // Last Build() can only have removed matches (query extended, or exclusion added)
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -2225,6 +2343,7 @@ struct ImGuiTextBuffer
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// With SetUseHashIndex(true) pairs are appended unsorted and found through an open addressing index instead, for large sets with frequent insertion (O(1) instead of O(N) memmove).
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2242,11 +2361,15 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+    ImVector<int>                   HashIndex;      // [Internal] Linear probing table of indices into Data (-1 = empty slot), power of two size. Only when UseHashIndex is set.
+    bool                            UseHashIndex;   // Pairs are stored in insertion order and looked up through HashIndex (see SetUseHashIndex)
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    ImGuiStorage()      { UseHashIndex = false; }
+
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N), or O(1) with a hash index.
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    void                Clear() { Data.clear(); HashIndex.clear(); }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2270,6 +2393,10 @@ struct ImGuiStorage
 
     // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
     IMGUI_API void      BuildSortByKey();
+
+    // Switch between the sorted vector (default, smallest) and the hash index (for thousands of keys). Existing pairs are kept.
+    IMGUI_API void      SetUseHashIndex(bool use_hash_index);
+    IMGUI_API void      BuildHashIndex();
 };
 
 // Helper: Manually clip large list of items.
@@ -2482,7 +2609,8 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLines        = 1 << 0,  // Enable anti-aliased lines/borders (*2 the number of triangles for 1.0f wide line or lines thin enough to be drawn using textures, otherwise *3 the number of triangles)
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering.
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
-    ImDrawListFlags_AllowVtxOffset          = 1 << 3   // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_CullOffscreen           = 1 << 4   // Add functions for shapes/images return early when the shape bounding box is entirely outside of the current clip rectangle. Set when 'style.CullOffscreenPrimitives' is enabled.
 };
 
 // Draw command list
@@ -2494,6 +2622,7 @@ enum ImDrawListFlags_
 // In single viewport mode, top-left is == GetMainViewport()->Pos (generally 0,0), bottom-right is == GetMainViewport()->Pos+Size (generally io.DisplaySize).
 // You are totally free to apply whatever transformation matrix to want to the data (depending on the use of the transformation you may want to apply it to ClipRect as well!)
 // Important: Primitives are always added to the list and not culled (culling is done at higher-level by ImGui:: functions), if you use this API a lot consider coarse culling your drawn objects.
+// (With ImDrawListFlags_CullOffscreen, shapes and images whose bounding box is entirely outside of the current clip rectangle are rejected on the CPU. Paths, polylines and text are not affected.)
 struct ImDrawList
 {
     // This is what you have to render
@@ -2514,6 +2643,11 @@ struct ImDrawList
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    int                     _CulledPrimCount;   // [Internal] number of primitives rejected by ImDrawListFlags_CullOffscreen since the last _ResetForNewFrame()
+    int                     _PeakCmdCount;      // [Internal] high-water mark of CmdBuffer.Size over the current shrink window
+    int                     _PeakIdxCount;      // [Internal] high-water mark of IdxBuffer.Size over the current shrink window
+    int                     _PeakVtxCount;      // [Internal] high-water mark of VtxBuffer.Size over the current shrink window
+    int                     _ShrinkFrameCount;  // [Internal] frames elapsed in the current shrink window, see IM_DRAWLIST_SHRINK_FRAMES
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
     ImDrawList(const ImDrawListSharedData* shared_data) { memset(this, 0, sizeof(*this)); _Data = shared_data; }
@@ -2607,11 +2741,13 @@ struct ImDrawList
     // [Internal helpers]
     IMGUI_API void  _ResetForNewFrame();
     IMGUI_API void  _ClearFreeMemory();
+    IMGUI_API void  _ShrinkAfterPeak();
     IMGUI_API void  _PopUnusedDrawCmd();
     IMGUI_API void  _TryMergeDrawCmds();
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
+    IMGUI_API bool  _CullRect(const ImVec2& bb_min, const ImVec2& bb_max, float pad);
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
@@ -2716,7 +2852,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoGlyphRunCache    = 1 << 3    // Don't cache laid out glyph quads and text sizes of short strings (RenderText()/CalcTextSizeA() will always decode and lay out text)
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2830,6 +2967,10 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Text layout cache
+    // mutable: filled by the const ImFont::CalcTextSizeA()/RenderText(). It only memoizes their results, the atlas state they observe is unchanged.
+    mutable ImFontGlyphRunCache* GlyphRunCache;     // Allocated on first use, cleared whenever fonts are rebuilt or cleared.
+
     // [Obsolete]
     //typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     //typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
@@ -2879,6 +3020,7 @@ struct ImFont
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
 
     // [Internal] Don't use!
+    IMGUI_API void              RenderTextNoCache(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const;
     IMGUI_API void              BuildLookupTable();
     IMGUI_API void              ClearOutputData();
     IMGUI_API void              GrowIndex(int new_size);
@@ -16,6 +16,7 @@ Index of this file:
 // [SECTION] ImFontAtlas glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
+// [SECTION] ImFontGlyphRunCache
 // [SECTION] ImGui Internal Render Helpers
 // [SECTION] Decompression code
 // [SECTION] Default font data (ProggyClean.ttf)
@@ -406,6 +407,7 @@ void ImDrawList::_ResetForNewFrame()
     IM_STATIC_ASSERT(IM_OFFSETOF(ImDrawCmd, TextureId) == sizeof(ImVec4));
     IM_STATIC_ASSERT(IM_OFFSETOF(ImDrawCmd, VtxOffset) == sizeof(ImVec4) + sizeof(ImTextureID));
 
+    _ShrinkAfterPeak();
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
@@ -420,6 +422,7 @@ void ImDrawList::_ResetForNewFrame()
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = 1.0f;
+    _CulledPrimCount = 0;
 }
 
 void ImDrawList::_ClearFreeMemory()
@@ -435,6 +438,36 @@ void ImDrawList::_ClearFreeMemory()
     _TextureIdStack.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _CulledPrimCount = 0;
+    _PeakCmdCount = _PeakIdxCount = _PeakVtxCount = 0;
+    _ShrinkFrameCount = 0;
+}
+
+// Called on the previous frame contents, before the buffers are reset.
+// Capacity is otherwise kept forever, so a single frame with a spike of primitives would pin its peak memory.
+template<typename T>
+static void ShrinkDrawListBuffer(ImVector<T>& buf, int peak)
+{
+    if (buf.Capacity > IM_DRAWLIST_SHRINK_MIN_CAPACITY && buf.Capacity > peak * IM_DRAWLIST_SHRINK_RATIO)
+    {
+        buf.clear();
+        buf.reserve(peak);
+    }
+}
+
+void ImDrawList::_ShrinkAfterPeak()
+{
+    _PeakCmdCount = ImMax(_PeakCmdCount, CmdBuffer.Size);
+    _PeakIdxCount = ImMax(_PeakIdxCount, IdxBuffer.Size);
+    _PeakVtxCount = ImMax(_PeakVtxCount, VtxBuffer.Size);
+    if (++_ShrinkFrameCount < IM_DRAWLIST_SHRINK_FRAMES)
+        return;
+    ShrinkDrawListBuffer(CmdBuffer, _PeakCmdCount);
+    ShrinkDrawListBuffer(IdxBuffer, _PeakIdxCount);
+    ShrinkDrawListBuffer(VtxBuffer, _PeakVtxCount);
+    ShrinkDrawListBuffer(_Path, 0);
+    _PeakCmdCount = _PeakIdxCount = _PeakVtxCount = 0;
+    _ShrinkFrameCount = 0;
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
@@ -569,6 +602,19 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+// Return true when ImDrawListFlags_CullOffscreen is set and the bounding box grown by 'pad' (half the stroke thickness + AA fringe) is entirely outside of the current clip rectangle.
+// Lists with no clip rectangle pushed are never culled: _CmdHeader.ClipRect is still zero-cleared at that point.
+bool ImDrawList::_CullRect(const ImVec2& bb_min, const ImVec2& bb_max, float pad)
+{
+    if (!(Flags & ImDrawListFlags_CullOffscreen) || _ClipRectStack.Size == 0)
+        return false;
+    const ImVec4& cr = _ClipRectStack.Data[_ClipRectStack.Size - 1];
+    if (bb_max.x + pad >= cr.x && bb_max.y + pad >= cr.y && bb_min.x - pad <= cr.z && bb_min.y - pad <= cr.w)
+        return false;
+    _CulledPrimCount++;
+    return true;
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -1383,6 +1429,8 @@ void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float th
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(p1, p2), ImMax(p1, p2), thickness * 0.5f + _FringeScale + 0.5f))
+        return;
     PathLineTo(p1 + ImVec2(0.5f, 0.5f));
     PathLineTo(p2 + ImVec2(0.5f, 0.5f));
     PathStroke(col, 0, thickness);
@@ -1394,6 +1442,8 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(p_min, p_max), ImMax(p_min, p_max), thickness * 0.5f + _FringeScale))
+        return;
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
@@ -1405,6 +1455,8 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(p_min, p_max), ImMax(p_min, p_max), _FringeScale))
+        return;
     if (rounding <= 0.0f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
         PrimReserve(6, 4);
@@ -1422,6 +1474,8 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
 {
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(p_min, p_max), ImMax(p_min, p_max), 0.0f))
+        return;
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
@@ -1437,6 +1491,8 @@ void ImDrawList::AddQuad(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, c
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), ImMin(p3, p4)), ImMax(ImMax(p1, p2), ImMax(p3, p4)), thickness * 0.5f + _FringeScale))
+        return;
 
     PathLineTo(p1);
     PathLineTo(p2);
@@ -1449,6 +1505,8 @@ void ImDrawList::AddQuadFilled(const ImVec2& p1, const ImVec2& p2, const ImVec2&
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), ImMin(p3, p4)), ImMax(ImMax(p1, p2), ImMax(p3, p4)), _FringeScale))
+        return;
 
     PathLineTo(p1);
     PathLineTo(p2);
@@ -1461,6 +1519,8 @@ void ImDrawList::AddTriangle(const ImVec2& p1, const ImVec2& p2, const ImVec2& p
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), p3), ImMax(ImMax(p1, p2), p3), thickness * 0.5f + _FringeScale))
+        return;
 
     PathLineTo(p1);
     PathLineTo(p2);
@@ -1472,6 +1532,8 @@ void ImDrawList::AddTriangleFilled(const ImVec2& p1, const ImVec2& p2, const ImV
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), p3), ImMax(ImMax(p1, p2), p3), _FringeScale))
+        return;
 
     PathLineTo(p1);
     PathLineTo(p2);
@@ -1483,6 +1545,8 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
 {
     if ((col & IM_COL32_A_MASK) == 0 || radius <= 0.0f)
         return;
+    if (_CullRect(center - ImVec2(radius, radius), center + ImVec2(radius, radius), thickness * 0.5f + _FringeScale))
+        return;
 
     if (num_segments <= 0)
     {
@@ -1507,6 +1571,8 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
 {
     if ((col & IM_COL32_A_MASK) == 0 || radius <= 0.0f)
         return;
+    if (_CullRect(center - ImVec2(radius, radius), center + ImVec2(radius, radius), _FringeScale))
+        return;
 
     if (num_segments <= 0)
     {
@@ -1532,6 +1598,8 @@ void ImDrawList::AddNgon(const ImVec2& center, float radius, ImU32 col, int num_
 {
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
+    if (_CullRect(center - ImVec2(ImFabs(radius), ImFabs(radius)), center + ImVec2(ImFabs(radius), ImFabs(radius)), thickness * 0.5f + _FringeScale))
+        return;
 
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1544,6 +1612,8 @@ void ImDrawList::AddNgonFilled(const ImVec2& center, float radius, ImU32 col, in
 {
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
+    if (_CullRect(center - ImVec2(ImFabs(radius), ImFabs(radius)), center + ImVec2(ImFabs(radius), ImFabs(radius)), _FringeScale))
+        return;
 
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1556,6 +1626,8 @@ void ImDrawList::AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), ImMin(p3, p4)), ImMax(ImMax(p1, p2), ImMax(p3, p4)), thickness * 0.5f + _FringeScale)) // Curve is contained in the hull of its control points
+        return;
 
     PathLineTo(p1);
     PathBezierCubicCurveTo(p2, p3, p4, num_segments);
@@ -1567,6 +1639,8 @@ void ImDrawList::AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const Im
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), p3), ImMax(ImMax(p1, p2), p3), thickness * 0.5f + _FringeScale)) // Curve is contained in the hull of its control points
+        return;
 
     PathLineTo(p1);
     PathBezierQuadraticCurveTo(p2, p3, num_segments);
@@ -1611,6 +1685,8 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(p_min, p_max), ImMax(p_min, p_max), 0.0f))
+        return;
 
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
@@ -1627,6 +1703,8 @@ void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, con
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(ImMin(p1, p2), ImMin(p3, p4)), ImMax(ImMax(p1, p2), ImMax(p3, p4)), 0.0f))
+        return;
 
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
@@ -1643,6 +1721,8 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_CullRect(ImMin(p_min, p_max), ImMax(p_min, p_max), _FringeScale))
+        return;
 
     flags = FixRectCornerFlags(flags);
     if (rounding <= 0.0f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
@@ -1983,6 +2063,9 @@ ImFontAtlas::~ImFontAtlas()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     Clear();
+    if (GlyphRunCache)
+        IM_DELETE(GlyphRunCache);
+    GlyphRunCache = NULL;
 }
 
 void    ImFontAtlas::ClearInputData()
@@ -2026,6 +2109,8 @@ void    ImFontAtlas::ClearFonts()
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     Fonts.clear_delete();
     TexReady = false;
+    if (GlyphRunCache)
+        GlyphRunCache->Clear();
 }
 
 void    ImFontAtlas::Clear()
@@ -2803,6 +2888,10 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
         if (atlas->Fonts[i]->DirtyLookupTables)
             atlas->Fonts[i]->BuildLookupTable();
 
+    // Cached glyph runs refer to the previous glyph metrics and UVs
+    if (atlas->GlyphRunCache)
+        atlas->GlyphRunCache->Clear();
+
     atlas->TexReady = true;
 }
 
@@ -3428,11 +3517,41 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     return s;
 }
 
+// Unwrapped printable ASCII never goes through the glyph run cache: the ASCII fast paths of CalcTextSizeA() and RenderTextNoCache()
+// lay it out as fast as a cache hit replays it (see Bench/TextLayoutBench.cpp). Strings past the cache length limit are not scanned.
+static inline bool IsUncachedAsciiText(float wrap_width, const char* text, const char* text_end)
+{
+    int text_len = (int)(text_end - text);
+    if (wrap_width > 0.0f || text_len > IMGUI_FONT_GLYPH_RUN_MAX_TEXT_LEN)
+        return false;
+    ImU64 bits = 0;
+    for (; text_len >= 8; text += 8, text_len -= 8)
+    {
+        ImU64 w;
+        memcpy(&w, text, 8);
+        bits |= w;
+    }
+    for (; text_len > 0; text++, text_len--)
+        bits |= (unsigned char)*text;
+    return (bits & 0x8080808080808080ULL) == 0;
+}
+
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    // Unbounded measurements of short strings are cached alongside their glyph runs (ImFontAtlas::GlyphRunCache is mutable for this)
+    ImFontGlyphRun* run = NULL;
+    if (max_width == FLT_MAX && remaining == NULL && ContainerAtlas && !(ContainerAtlas->Flags & ImFontAtlasFlags_NoGlyphRunCache) && !IsUncachedAsciiText(wrap_width, text_begin, text_end))
+    {
+        if (ContainerAtlas->GlyphRunCache == NULL)
+            ContainerAtlas->GlyphRunCache = IM_NEW(ImFontGlyphRunCache)();
+        run = ContainerAtlas->GlyphRunCache->GetOrAdd(this, size, wrap_width, text_begin, text_end);
+        if (run && run->HasTextSize)
+            return run->TextSize;
+    }
+
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -3442,6 +3561,10 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // Printable ASCII (0x20..0x7F) runs skip UTF-8 decoding, control character checks and the advance table bounds check
+    const bool ascii_dense = IndexAdvanceX.Size >= 0x80;
+    bool reached_max_width = false;
+
     const char* s = text_begin;
     while (s < text_end)
     {
@@ -3473,6 +3596,27 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        if (ascii_dense && (unsigned char)*s - 0x20u < 0x60u)
+        {
+            // Run is bounded by the wrapping point so the check above still happens at the same character.
+            // Classifying bytes in the same pass is free next to the serial width accumulation, a separate vectorized scan measured slower.
+            const char* run_end = word_wrap_eol ? word_wrap_eol : text_end;
+            const float* advance_x = IndexAdvanceX.Data;
+            for (; s < run_end && (unsigned char)*s - 0x20u < 0x60u; s++)
+            {
+                const float char_width = advance_x[(unsigned char)*s] * scale;
+                if (line_width + char_width >= max_width)
+                {
+                    reached_max_width = true;
+                    break;
+                }
+                line_width += char_width;
+            }
+            if (reached_max_width)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3519,6 +3663,12 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (remaining)
         *remaining = s;
 
+    if (run)
+    {
+        run->TextSize = text_size;
+        run->HasTextSize = true;
+    }
+
     return text_size;
 }
 
@@ -3538,11 +3688,122 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
+// Short strings are laid out once and replayed from the atlas glyph run cache on subsequent calls (see ImFontGlyphRunCache).
 void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
 
+    // CPU fine clipping modifies quads against the clip rectangle, which doesn't fit a position independent layout.
+    if (cpu_fine_clip || ContainerAtlas == NULL || (ContainerAtlas->Flags & ImFontAtlasFlags_NoGlyphRunCache) || IsUncachedAsciiText(wrap_width, text_begin, text_end))
+    {
+        RenderTextNoCache(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip);
+        return;
+    }
+
+    pos.x = IM_FLOOR(pos.x);
+    pos.y = IM_FLOOR(pos.y);
+    if (pos.y > clip_rect.w)
+        return;
+
+    // Filled from this const method: ImFontAtlas::GlyphRunCache is mutable
+    if (ContainerAtlas->GlyphRunCache == NULL)
+        ContainerAtlas->GlyphRunCache = IM_NEW(ImFontGlyphRunCache)();
+    ImFontGlyphRun* run = ContainerAtlas->GlyphRunCache->GetOrAdd(this, size, wrap_width, text_begin, text_end);
+    if (run == NULL)
+    {
+        RenderTextNoCache(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, false);
+        return;
+    }
+
+    if (!run->HasQuads)
+    {
+        // With 16-bit indices PrimReserve() may start a new draw command, which the rollback below cannot undo: lay out without caching this time.
+        if (sizeof(ImDrawIdx) == 2 && draw_list->_VtxCurrentIdx + (unsigned int)(text_end - text_begin) * 4 >= (1 << 16))
+        {
+            RenderTextNoCache(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, false);
+            return;
+        }
+
+        // Lay out the whole string without clipping, using a zero color so colored glyphs can be detected (they output ~IM_COL32_A_MASK).
+        // The quads are copied into the run, then the emitted vertices are rolled back and the run is replayed below with the clip test.
+        const ImVec4 no_clip_rect(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX);
+        const int vtx_begin = draw_list->VtxBuffer.Size;
+        const int idx_begin = draw_list->IdxBuffer.Size;
+        const unsigned int elem_count = draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount;
+        const unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+        RenderTextNoCache(draw_list, size, pos, 0, no_clip_rect, text_begin, text_end, wrap_width, false);
+        const int quad_count = (draw_list->VtxBuffer.Size - vtx_begin) / 4;
+        const ImDrawVert* vtx = draw_list->VtxBuffer.Data + vtx_begin;
+        const bool stored = ContainerAtlas->GlyphRunCache->AllocQuads(run, quad_count);
+        ImFontGlyphRunQuad* quad = run->Quads.Data;
+        for (int n = 0; n < quad_count; n++, vtx += 4)
+        {
+            run->HasColoredGlyphs |= (vtx[0].col != 0);
+            if (!stored)
+                continue;
+            quad[n].P0 = ImVec2(vtx[0].pos.x - pos.x, vtx[0].pos.y - pos.y);
+            quad[n].P1 = ImVec2(vtx[2].pos.x - pos.x, vtx[2].pos.y - pos.y);
+            quad[n].UV0 = vtx[0].uv;
+            quad[n].UV1 = vtx[2].uv;
+        }
+        run->HasQuads = true;
+        run->SkipQuads = !stored;
+
+        draw_list->VtxBuffer.Size = vtx_begin;
+        draw_list->IdxBuffer.Size = idx_begin;
+        draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount = elem_count;
+        draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + vtx_begin;
+        draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + idx_begin;
+        draw_list->_VtxCurrentIdx = vtx_current_idx;
+    }
+    if (run->HasColoredGlyphs || run->SkipQuads)
+    {
+        RenderTextNoCache(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, false);
+        return;
+    }
+
+    const int vtx_count_max = run->Quads.Size * 4;
+    if (vtx_count_max == 0)
+        return;
+    const int idx_count_max = run->Quads.Size * 6;
+    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+    for (const ImFontGlyphRunQuad* quad = run->Quads.Data, *quad_end = run->Quads.Data + run->Quads.Size; quad < quad_end; quad++)
+    {
+        const float x1 = pos.x + quad->P0.x, y1 = pos.y + quad->P0.y;
+        const float x2 = pos.x + quad->P1.x, y2 = pos.y + quad->P1.y;
+        if (x1 > clip_rect.z || x2 < clip_rect.x || y1 > clip_rect.w || y2 < clip_rect.y)
+            continue;
+        const float u1 = quad->UV0.x, v1 = quad->UV0.y, u2 = quad->UV1.x, v2 = quad->UV1.y;
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+        vtx_write += 4;
+        vtx_current_idx += 4;
+        idx_write += 6;
+    }
+
+    // Give back unused vertices (clipped ones) ~ this is essentially a PrimUnreserve() action.
+    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data);
+    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+}
+
+void ImFont::RenderTextNoCache(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
+{
+
     // Align to be pixel perfect
     pos.x = IM_FLOOR(pos.x);
     pos.y = IM_FLOOR(pos.y);
@@ -3595,6 +3856,9 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
 
+    // Printable ASCII (0x20..0x7F) runs skip UTF-8 decoding, control character checks and the FindGlyph() call
+    const bool ascii_dense = IndexLookup.Size >= 0x80 && !cpu_fine_clip;
+
     while (s < text_end)
     {
         if (word_wrap_enabled)
@@ -3623,6 +3887,43 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+        if (ascii_dense && (unsigned char)*s - 0x20u < 0x60u)
+        {
+            // Run is bounded by the wrapping point so the check above still happens at the same character. Same output as the loop below without cpu_fine_clip.
+            const char* run_end = word_wrap_eol ? word_wrap_eol : text_end;
+            const ImWchar* lookup = IndexLookup.Data;
+            for (; s < run_end && (unsigned char)*s - 0x20u < 0x60u; s++)
+            {
+                const ImWchar glyph_index = lookup[(unsigned char)*s];
+                const ImFontGlyph* glyph = (glyph_index == (ImWchar)-1) ? FallbackGlyph : &Glyphs.Data[glyph_index];
+                if (glyph == NULL)
+                    continue;
+                if (glyph->Visible)
+                {
+                    const float x1 = x + glyph->X0 * scale;
+                    const float x2 = x + glyph->X1 * scale;
+                    if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                    {
+                        const float y1 = y + glyph->Y0 * scale;
+                        const float y2 = y + glyph->Y1 * scale;
+                        const float u1 = glyph->U0, v1 = glyph->V0, u2 = glyph->U1, v2 = glyph->V1;
+                        const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+                        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                        vtx_write += 4;
+                        vtx_current_idx += 4;
+                        idx_write += 6;
+                    }
+                }
+                x += glyph->AdvanceX * scale;
+            }
+            continue;
+        }
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -3729,6 +4030,111 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->_VtxCurrentIdx = vtx_current_idx;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImFontGlyphRunCache
+//-----------------------------------------------------------------------------
+
+void ImFontGlyphRunCache::Clear()
+{
+    for (int n = 0; n < Runs.Size; n++)
+    {
+        Runs[n].Text.clear();
+        Runs[n].Quads.clear();
+    }
+    Runs.clear();
+    Tick = 0;
+    BytesUsed = 0;
+}
+
+// Return the cached run for this key, or recycle the least recently used entry of its set for it (with HasQuads/HasTextSize cleared).
+// Return NULL for strings not worth caching, or when the byte budget is exhausted.
+ImFontGlyphRun* ImFontGlyphRunCache::GetOrAdd(const ImFont* font, float size, float wrap_width, const char* text, const char* text_end)
+{
+    const int text_len = (int)(text_end - text);
+    if (text_len <= 0 || text_len > IMGUI_FONT_GLYPH_RUN_MAX_TEXT_LEN)
+        return NULL;
+    if (wrap_width <= 0.0f)
+        wrap_width = 0.0f; // Any non-positive width disables wrapping (CalcTextSize() passes -1.0f, AddText() passes 0.0f)
+
+    if (Runs.Size == 0)
+    {
+        Runs.resize(IMGUI_FONT_GLYPH_RUN_CACHE_SETS * IMGUI_FONT_GLYPH_RUN_CACHE_WAYS);
+        memset(Runs.Data, 0, (size_t)Runs.size_in_bytes());
+        BytesUsed = (size_t)Runs.size_in_bytes();
+    }
+
+    const ImU64 hash = HashText(text, text_len, (ImU64)(size_t)font);
+    ImFontGlyphRun* set = &Runs.Data[(hash & (IMGUI_FONT_GLYPH_RUN_CACHE_SETS - 1)) * IMGUI_FONT_GLYPH_RUN_CACHE_WAYS];
+    ImFontGlyphRun* victim = set;
+    Tick++;
+    for (int way = 0; way < IMGUI_FONT_GLYPH_RUN_CACHE_WAYS; way++)
+    {
+        ImFontGlyphRun* run = &set[way];
+        if (run->LastUsed != 0 && run->Hash == hash && run->Font == font && run->Size == size && run->WrapWidth == wrap_width && run->Text.Size == text_len && memcmp(run->Text.Data, text, (size_t)text_len) == 0)
+        {
+            run->LastUsed = Tick;
+            return run;
+        }
+        if (run->LastUsed < victim->LastUsed)
+            victim = run;
+    }
+
+    // Recycle the least recently used entry. Its buffers are released so BytesUsed only counts live runs
+    BytesUsed -= (size_t)victim->Text.Capacity + (size_t)victim->Quads.Capacity * sizeof(ImFontGlyphRunQuad);
+    victim->Text.clear();
+    victim->Quads.clear();
+    victim->LastUsed = 0;
+    if (BytesUsed + (size_t)text_len > IMGUI_FONT_GLYPH_RUN_CACHE_MAX_BYTES)
+        return NULL;
+
+    victim->Hash = hash;
+    victim->Font = font;
+    victim->Size = size;
+    victim->WrapWidth = wrap_width;
+    victim->LastUsed = Tick;
+    victim->HasQuads = victim->HasColoredGlyphs = victim->SkipQuads = victim->HasTextSize = false;
+    victim->Text.reserve(text_len);
+    victim->Text.resize(text_len);
+    memcpy(victim->Text.Data, text, (size_t)text_len);
+    BytesUsed += (size_t)victim->Text.Capacity;
+    return victim;
+}
+
+// Size run->Quads for 'count' quads. False if it would exceed the byte budget (the run is then always laid out from scratch)
+bool ImFontGlyphRunCache::AllocQuads(ImFontGlyphRun* run, int count)
+{
+    IM_ASSERT(run->Quads.Capacity == 0);
+    const size_t bytes = (size_t)count * sizeof(ImFontGlyphRunQuad);
+    if (BytesUsed + bytes > IMGUI_FONT_GLYPH_RUN_CACHE_MAX_BYTES)
+        return false;
+    run->Quads.reserve(count);
+    run->Quads.resize(count);
+    BytesUsed += bytes;
+    return true;
+}
+
+// Cheaper than ImHashData() for a cache key: 8 bytes per step, and the key text is compared on hit anyway.
+ImU64 ImFontGlyphRunCache::HashText(const char* text, int text_len, ImU64 seed)
+{
+    const ImU64 mul = 0x9E3779B97F4A7C15ULL;
+    ImU64 h = (seed ^ (ImU64)text_len) * mul;
+    for (; text_len >= 8; text += 8, text_len -= 8)
+    {
+        ImU64 w;
+        memcpy(&w, text, 8);
+        h = (h ^ w) * mul;
+        h ^= h >> 29;
+    }
+    if (text_len > 0)
+    {
+        ImU64 w = 0;
+        memcpy(&w, text, (size_t)text_len);
+        h = (h ^ w) * mul;
+    }
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDULL; h ^= h >> 33; // Finalize so the low bits used for set selection depend on every input byte
+    return h;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGui Internal Render Helpers
 //-----------------------------------------------------------------------------
@@ -60,6 +60,12 @@ Index of this file:
 #include <immintrin.h>
 #endif
 
+// Enable NEON intrinsics if available
+#if defined(__ARM_NEON) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -328,6 +334,8 @@ IMGUI_API void          ImStrTrimBlanks(char* str);
 IMGUI_API const char*   ImStrSkipBlank(const char* str);
 IMGUI_API int           ImFormatString(char* buf, size_t buf_size, const char* fmt, ...) IM_FMTARGS(3);
 IMGUI_API int           ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args) IM_FMTLIST(3);
+IMGUI_API int           ImFormatStringFast(char* buf, size_t buf_size, const char* fmt, ...) IM_FMTARGS(3);          // Same output as ImFormatString(), converts a single %d/%i/%u/%x/%X/%f/%.Nf argument without vsnprintf()
+IMGUI_API int           ImFormatStringFastV(char* buf, size_t buf_size, const char* fmt, va_list args) IM_FMTLIST(3);
 IMGUI_API const char*   ImParseFormatFindStart(const char* format);
 IMGUI_API const char*   ImParseFormatFindEnd(const char* format);
 IMGUI_API const char*   ImParseFormatTrimDecorations(const char* format, char* buf, size_t buf_size);
@@ -707,6 +715,14 @@ struct ImChunkStream
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: give back buffer memory after a spike.
+// Every IM_DRAWLIST_SHRINK_FRAMES frames, a buffer whose capacity exceeds IM_DRAWLIST_SHRINK_RATIO times the peak size seen during those frames is reallocated to that peak.
+#ifndef IM_DRAWLIST_SHRINK_FRAMES
+#define IM_DRAWLIST_SHRINK_FRAMES                               120
+#endif
+#define IM_DRAWLIST_SHRINK_RATIO                                2
+#define IM_DRAWLIST_SHRINK_MIN_CAPACITY                         1024 // Below this capacity buffers are never shrunk, reallocating would cost more than it gives back.
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -1592,6 +1608,7 @@ struct ImGuiContext
 
     // Item/widgets state and tracking information
     ImGuiID                 DebugHookIdInfo;                    // Will call core hooks: DebugHookIdInfo() from GetID functions, used by Stack Tool [next HoveredId/ActiveId to not pull in an extra cache-line]
+    ImGuiStaticID*          NextItemStaticID;                   // Set by widget overloads taking an ImGuiStaticID: the next ImGuiWindow::GetID() call on its Label uses the precomputed hash.
     ImGuiID                 HoveredId;                          // Hovered widget, filled during the frame
     ImGuiID                 HoveredIdPreviousFrame;
     bool                    HoveredIdAllowOverlap;
@@ -1823,6 +1840,9 @@ struct ImGuiContext
         TestEngine = NULL;
 
         WindowsActiveCount = 0;
+#ifndef IMGUI_DISABLE_STORAGE_HASH_INDEX
+        WindowsById.UseHashIndex = true;
+#endif
         CurrentWindow = NULL;
         HoveredWindow = NULL;
         HoveredWindowUnderMovingWindow = NULL;
@@ -1831,6 +1851,7 @@ struct ImGuiContext
         WheelingWindowTimer = 0.0f;
 
         DebugHookIdInfo = 0;
+        NextItemStaticID = NULL;
         HoveredId = HoveredIdPreviousFrame = 0;
         HoveredIdAllowOverlap = false;
         HoveredIdUsingMouseWheel = HoveredIdPreviousFrameUsingMouseWheel = false;
@@ -2010,6 +2031,22 @@ struct IMGUI_API ImGuiWindowTempData
     ImVector<float>         TextWrapPosStack;       // Store text wrap pos to restore (attention: .back() is not == TextWrapPos)
 };
 
+// Formatted value kept by TextScalar()/LabelTextScalar(), reused as long as the value, format and font are unchanged
+#define IMGUI_TEXT_VALUE_CACHE_MAX_LEN  64
+struct ImGuiTextValueCacheEntry
+{
+    ImGuiID                 ID;                     // Hash of the ID stack, format string and value address
+    int                     LastFrameUsed;
+    ImGuiDataType           DataType;
+    ImU64                   Data;                   // Value bytes (zero padded)
+    ImFont*                 Font;
+    float                   FontSize;
+    float                   WrapWidth;
+    ImVec2                  TextSize;
+    int                     TextLen;
+    char                    Text[IMGUI_TEXT_VALUE_CACHE_MAX_LEN];
+};
+
 // Storage for one window
 struct IMGUI_API ImGuiWindow
 {
@@ -2086,6 +2123,10 @@ struct IMGUI_API ImGuiWindow
     float                   ItemWidthDefault;
     ImGuiStorage            StateStorage;
     ImVector<ImGuiOldColumns> ColumnsStorage;
+    ImVector<ImGuiTextValueCacheEntry> TextValueCache;  // TextScalar()/LabelTextScalar() results, entries unused for a while are dropped when the cache outgrows twice the values displayed per frame
+    ImGuiStorage            TextValueCacheMap;          // ID -> index into TextValueCache
+    int                     TextValueCacheFrame;        // Last frame the cache was used
+    int                     TextValueCacheUsedCount;    // Entries used during that frame
     float                   FontWindowScale;                    // User scale multiplier per-window, via SetWindowFontScale()
     int                     SettingsOffset;                     // Offset into SettingsWindows[] (offsets are always valid as we only grow the array from the back)
 
@@ -2116,6 +2157,10 @@ public:
     ImGuiID     GetIDNoKeepAlive(const char* str, const char* str_end = NULL);
     ImGuiID     GetIDNoKeepAlive(const void* ptr);
     ImGuiID     GetIDNoKeepAlive(int n);
+#ifdef IMGUI_HAS_STATIC_ID
+    ImGuiID     GetID(ImGuiStaticID& static_id);
+    ImGuiID     GetIDNoKeepAlive(ImGuiStaticID& static_id);
+#endif
     ImGuiID     GetIDFromRectangle(const ImRect& r_abs);
 
     // We don't use g.FontSize because the window may be != g.CurrentWidow.
@@ -2818,6 +2863,7 @@ namespace ImGui
     // Data type helpers
     IMGUI_API const ImGuiDataTypeInfo*  DataTypeGetInfo(ImGuiDataType data_type);
     IMGUI_API int           DataTypeFormatString(char* buf, int buf_size, ImGuiDataType data_type, const void* p_data, const char* format);
+    IMGUI_API ImGuiTextValueCacheEntry* GetTextValueCacheEntry(ImGuiDataType data_type, const void* p_data, const char* format, float wrap_width);
     IMGUI_API void          DataTypeApplyOp(ImGuiDataType data_type, int op, void* output, const void* arg_1, const void* arg_2);
     IMGUI_API bool          DataTypeApplyFromText(const char* buf, ImGuiDataType data_type, void* p_data, const char* format);
     IMGUI_API int           DataTypeCompare(ImGuiDataType data_type, const void* arg_1, const void* arg_2);
@@ -2896,6 +2942,57 @@ IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// Glyph run cache: vertices emitted by ImFont::RenderText() and sizes returned by ImFont::CalcTextSizeA() for recently used short strings,
+// so labels submitted every frame skip UTF-8 decoding and glyph lookups. Keyed by (font, size, wrap width, text).
+// Set-associative with LRU eviction within a set, capped in bytes. Unwrapped printable ASCII skips it before any lookup and takes the ASCII fast paths of CalcTextSizeA() / RenderTextNoCache() instead.
+// Owned by ImFontAtlas, cleared on atlas rebuild.
+#ifndef IMGUI_FONT_GLYPH_RUN_CACHE_SETS
+#define IMGUI_FONT_GLYPH_RUN_CACHE_SETS         1024    // Must be a power of two. Capacity = SETS * WAYS strings.
+#endif
+#define IMGUI_FONT_GLYPH_RUN_CACHE_WAYS         4
+#ifndef IMGUI_FONT_GLYPH_RUN_MAX_TEXT_LEN
+#define IMGUI_FONT_GLYPH_RUN_MAX_TEXT_LEN       128     // Longer strings are always laid out from scratch
+#endif
+#ifndef IMGUI_FONT_GLYPH_RUN_CACHE_MAX_BYTES
+#define IMGUI_FONT_GLYPH_RUN_CACHE_MAX_BYTES    (2 << 20) // Total budget: run table + key text + quads. Runs that don't fit are laid out from scratch
+#endif
+
+struct ImFontGlyphRunQuad
+{
+    ImVec2                  P0, P1;         // Relative to the floored text position
+    ImVec2                  UV0, UV1;
+};
+
+struct ImFontGlyphRun
+{
+    ImU64                   Hash;           // ImFontGlyphRunCache::HashText()
+    const ImFont*           Font;
+    float                   Size;
+    float                   WrapWidth;
+    ImU64                   LastUsed;       // ImFontGlyphRunCache::Tick at last lookup (0 = free slot)
+    bool                    HasQuads;
+    bool                    HasColoredGlyphs; // Colored glyphs ignore the tint color: such runs are always laid out from scratch
+    bool                    SkipQuads;      // Quads didn't fit in the byte budget: always laid out from scratch
+    bool                    HasTextSize;
+    ImVec2                  TextSize;       // CalcTextSizeA(Size, FLT_MAX, WrapWidth, Text)
+    ImVector<char>          Text;           // Copy of the key text (not zero-terminated)
+    ImVector<ImFontGlyphRunQuad> Quads;     // One per visible glyph
+};
+
+struct ImFontGlyphRunCache
+{
+    ImVector<ImFontGlyphRun> Runs;          // IMGUI_FONT_GLYPH_RUN_CACHE_SETS * IMGUI_FONT_GLYPH_RUN_CACHE_WAYS, allocated on first use
+    ImU64                   Tick;           // 64-bit: never wraps, so the LRU order within a set always holds
+    size_t                  BytesUsed;      // Runs + Text + Quads capacity, kept under IMGUI_FONT_GLYPH_RUN_CACHE_MAX_BYTES
+
+    ImFontGlyphRunCache()   { Tick = 0; BytesUsed = 0; }
+    ~ImFontGlyphRunCache()  { Clear(); }
+    IMGUI_API void          Clear();
+    IMGUI_API ImFontGlyphRun* GetOrAdd(const ImFont* font, float size, float wrap_width, const char* text, const char* text_end);
+    IMGUI_API bool          AllocQuads(ImFontGlyphRun* run, int count);
+    static ImU64            HashText(const char* text, int text_len, ImU64 seed);
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
@@ -276,7 +276,7 @@ void ImGui::TextV(const char* fmt, va_list args)
 
     // FIXME-OPT: Handle the %s shortcut?
     ImGuiContext& g = *GImGui;
-    const char* text_end = g.TempBuffer + ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    const char* text_end = g.TempBuffer + ImFormatStringFastV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
     TextEx(g.TempBuffer, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
 }
 
@@ -359,7 +359,7 @@ void ImGui::LabelTextV(const char* label, const char* fmt, va_list args)
     const float w = CalcItemWidth();
 
     const char* value_text_begin = &g.TempBuffer[0];
-    const char* value_text_end = value_text_begin + ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    const char* value_text_end = value_text_begin + ImFormatStringFastV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
     const ImVec2 value_size = CalcTextSize(value_text_begin, value_text_end, false);
     const ImVec2 label_size = CalcTextSize(label, NULL, true);
 
@@ -376,6 +376,169 @@ void ImGui::LabelTextV(const char* label, const char* fmt, va_list args)
         RenderText(ImVec2(value_bb.Max.x + style.ItemInnerSpacing.x, value_bb.Min.y + style.FramePadding.y), label);
 }
 
+// Return the formatted text and size of a value, only formatted and measured again when the value, format, font or wrap width changed.
+// Entries are keyed by the ID stack, format string and value address. Text too long for the entry is left in g.TempBuffer (and never reused).
+// Glyphs are laid out again every frame: unwrapped ASCII values skip the glyph run cache and take the ASCII fast path of ImFont::RenderTextNoCache().
+ImGuiTextValueCacheEntry* ImGui::GetTextValueCacheEntry(ImGuiDataType data_type, const void* p_data, const char* format, float wrap_width)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    const ImGuiDataTypeInfo* type_info = DataTypeGetInfo(data_type);
+
+    // Seed of the entry key. The format string is only hashed when it is neither pre-hashed (ImGuiStaticID overloads) nor the data type default
+    ImGuiID format_id;
+#ifdef IMGUI_HAS_STATIC_ID
+    if (format != NULL && g.NextItemStaticID != NULL && g.NextItemStaticID->Label == format)
+    {
+        format_id = window->GetIDNoKeepAlive(*g.NextItemStaticID);
+        g.NextItemStaticID = NULL;
+    }
+    else
+#endif
+    if (format == NULL)
+    {
+        format_id = window->GetIDNoKeepAlive((int)data_type);
+        format = type_info->PrintFmt;
+    }
+    else
+    {
+        format_id = window->GetIDNoKeepAlive(format);
+    }
+
+    // On the first use of a frame, drop entries unused during the previous one once the cache outgrew twice the values displayed per frame
+    ImVector<ImGuiTextValueCacheEntry>& cache = window->TextValueCache;
+    if (window->TextValueCacheFrame != g.FrameCount)
+    {
+        if (cache.Size > window->TextValueCacheUsedCount * 2 + 64)
+        {
+            int alive_count = 0;
+            for (int n = 0; n < cache.Size; n++)
+                if (cache[n].LastFrameUsed == window->TextValueCacheFrame)
+                    cache[alive_count++] = cache[n];
+            cache.resize(alive_count);
+            window->TextValueCacheMap.Data.resize(0);
+            for (int n = 0; n < alive_count; n++)
+                window->TextValueCacheMap.Data.push_back(ImGuiStorage::ImGuiStoragePair(cache[n].ID, n));
+            window->TextValueCacheMap.BuildSortByKey();
+        }
+        window->TextValueCacheFrame = g.FrameCount;
+        window->TextValueCacheUsedCount = 0;
+    }
+
+    const ImGuiID id = ImHashData(&p_data, sizeof(p_data), format_id);
+    int* p_index = window->TextValueCacheMap.GetIntRef(id, -1);
+    if (*p_index == -1)
+    {
+        *p_index = cache.Size;
+        cache.resize(cache.Size + 1);
+        memset(&cache.back(), 0, sizeof(ImGuiTextValueCacheEntry));
+        cache.back().ID = id;
+    }
+    ImGuiTextValueCacheEntry* entry = &cache[*p_index];
+    if (entry->LastFrameUsed != g.FrameCount)
+    {
+        entry->LastFrameUsed = g.FrameCount;
+        window->TextValueCacheUsedCount++;
+    }
+
+    ImU64 data = 0;
+    memcpy(&data, p_data, type_info->Size);
+    if (entry->Font == g.Font && entry->FontSize == g.FontSize && entry->WrapWidth == wrap_width && entry->DataType == data_type && entry->Data == data)
+        return entry;
+
+    entry->TextLen = DataTypeFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), data_type, p_data, format);
+    entry->TextSize = CalcTextSize(g.TempBuffer, g.TempBuffer + entry->TextLen, false, wrap_width);
+    entry->DataType = data_type;
+    entry->Data = data;
+    entry->WrapWidth = wrap_width;
+    entry->FontSize = g.FontSize;
+    if (entry->TextLen < IMGUI_TEXT_VALUE_CACHE_MAX_LEN)
+    {
+        memcpy(entry->Text, g.TempBuffer, (size_t)entry->TextLen + 1);
+        entry->Font = g.Font;
+    }
+    else
+    {
+        entry->Font = NULL;
+    }
+    return entry;
+}
+
+void ImGui::TextScalar(ImGuiDataType data_type, const void* p_data, const char* format)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+    ImGuiContext& g = *GImGui;
+
+    // Same layout as TextEx()
+    const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+    const float wrap_pos_x = window->DC.TextWrapPos;
+    const float wrap_width = (wrap_pos_x >= 0.0f) ? CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
+    const ImGuiTextValueCacheEntry* entry = GetTextValueCacheEntry(data_type, p_data, format, wrap_width);
+    const char* text_begin = (entry->TextLen < IMGUI_TEXT_VALUE_CACHE_MAX_LEN) ? entry->Text : g.TempBuffer;
+    const char* text_end = text_begin + entry->TextLen;
+    if (entry->TextLen > 2000 && wrap_pos_x < 0.0f)
+    {
+        TextEx(text_begin, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
+        return;
+    }
+
+    ImRect bb(text_pos, text_pos + entry->TextSize);
+    ItemSize(entry->TextSize, 0.0f);
+    if (!ItemAdd(bb, 0))
+        return;
+    RenderTextWrapped(bb.Min, text_begin, text_end, wrap_width);
+}
+
+// Same layout as LabelTextV()
+void ImGui::LabelTextScalar(const char* label, ImGuiDataType data_type, const void* p_data, const char* format)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    const ImGuiStyle& style = g.Style;
+    const float w = CalcItemWidth();
+
+    const ImGuiTextValueCacheEntry* entry = GetTextValueCacheEntry(data_type, p_data, format, -1.0f);
+    const char* value_text_begin = (entry->TextLen < IMGUI_TEXT_VALUE_CACHE_MAX_LEN) ? entry->Text : g.TempBuffer;
+    const char* value_text_end = value_text_begin + entry->TextLen;
+    const ImVec2 value_size = entry->TextSize;
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+
+    const ImVec2 pos = window->DC.CursorPos;
+    const ImRect value_bb(pos, pos + ImVec2(w, value_size.y + style.FramePadding.y * 2));
+    const ImRect total_bb(pos, pos + ImVec2(w + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), ImMax(value_size.y, label_size.y) + style.FramePadding.y * 2));
+    ItemSize(total_bb, style.FramePadding.y);
+    if (!ItemAdd(total_bb, 0))
+        return;
+
+    // Render
+    RenderTextClipped(value_bb.Min + style.FramePadding, value_bb.Max, value_text_begin, value_text_end, &value_size, ImVec2(0.0f, 0.0f));
+    if (label_size.x > 0.0f)
+        RenderText(ImVec2(value_bb.Max.x + style.ItemInnerSpacing.x, value_bb.Min.y + style.FramePadding.y), label);
+}
+
+#ifdef IMGUI_HAS_STATIC_ID
+void ImGui::TextScalar(ImGuiDataType data_type, const void* p_data, ImGuiStaticID& format)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &format;
+    TextScalar(data_type, p_data, format.Label);
+    g.NextItemStaticID = NULL;
+}
+
+void ImGui::LabelTextScalar(const char* label, ImGuiDataType data_type, const void* p_data, ImGuiStaticID& format)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &format;
+    LabelTextScalar(label, data_type, p_data, format.Label);
+    g.NextItemStaticID = NULL;
+}
+#endif
+
 void ImGui::BulletText(const char* fmt, ...)
 {
     va_list args;
@@ -395,7 +558,7 @@ void ImGui::BulletTextV(const char* fmt, va_list args)
     const ImGuiStyle& style = g.Style;
 
     const char* text_begin = g.TempBuffer;
-    const char* text_end = text_begin + ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    const char* text_end = text_begin + ImFormatStringFastV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
     const ImVec2 label_size = CalcTextSize(text_begin, text_end, false);
     const ImVec2 total_size = ImVec2(g.FontSize + (label_size.x > 0.0f ? (label_size.x + style.FramePadding.x * 2) : 0.0f), label_size.y);  // Empty text doesn't add padding
     ImVec2 pos = window->DC.CursorPos;
@@ -717,6 +880,17 @@ bool ImGui::Button(const char* label, const ImVec2& size_arg)
     return ButtonEx(label, size_arg, ImGuiButtonFlags_None);
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+bool ImGui::Button(ImGuiStaticID& label, const ImVec2& size_arg)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &label;
+    bool ret = ButtonEx(label.Label, size_arg, ImGuiButtonFlags_None);
+    g.NextItemStaticID = NULL;
+    return ret;
+}
+#endif
+
 // Small buttons fits within text without additional vertical spacing.
 bool ImGui::SmallButton(const char* label)
 {
@@ -1130,6 +1304,17 @@ bool ImGui::Checkbox(const char* label, bool* v)
     return pressed;
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+bool ImGui::Checkbox(ImGuiStaticID& label, bool* v)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &label;
+    bool ret = Checkbox(label.Label, v);
+    g.NextItemStaticID = NULL;
+    return ret;
+}
+#endif
+
 template<typename T>
 bool ImGui::CheckboxFlagsT(const char* label, T* flags, T flags_value)
 {
@@ -1925,21 +2110,21 @@ int ImGui::DataTypeFormatString(char* buf, int buf_size, ImGuiDataType data_type
 {
     // Signedness doesn't matter when pushing integer arguments
     if (data_type == ImGuiDataType_S32 || data_type == ImGuiDataType_U32)
-        return ImFormatString(buf, buf_size, format, *(const ImU32*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const ImU32*)p_data);
     if (data_type == ImGuiDataType_S64 || data_type == ImGuiDataType_U64)
-        return ImFormatString(buf, buf_size, format, *(const ImU64*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const ImU64*)p_data);
     if (data_type == ImGuiDataType_Float)
-        return ImFormatString(buf, buf_size, format, *(const float*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const float*)p_data);
     if (data_type == ImGuiDataType_Double)
-        return ImFormatString(buf, buf_size, format, *(const double*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const double*)p_data);
     if (data_type == ImGuiDataType_S8)
-        return ImFormatString(buf, buf_size, format, *(const ImS8*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const ImS8*)p_data);
     if (data_type == ImGuiDataType_U8)
-        return ImFormatString(buf, buf_size, format, *(const ImU8*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const ImU8*)p_data);
     if (data_type == ImGuiDataType_S16)
-        return ImFormatString(buf, buf_size, format, *(const ImS16*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const ImS16*)p_data);
     if (data_type == ImGuiDataType_U16)
-        return ImFormatString(buf, buf_size, format, *(const ImU16*)p_data);
+        return ImFormatStringFast(buf, buf_size, format, *(const ImU16*)p_data);
     IM_ASSERT(0);
     return 0;
 }
@@ -3073,6 +3258,17 @@ bool ImGui::SliderFloat(const char* label, float* v, float v_min, float v_max, c
     return SliderScalar(label, ImGuiDataType_Float, v, &v_min, &v_max, format, flags);
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+bool ImGui::SliderFloat(ImGuiStaticID& label, float* v, float v_min, float v_max, const char* format, ImGuiSliderFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &label;
+    bool ret = SliderScalar(label.Label, ImGuiDataType_Float, v, &v_min, &v_max, format, flags);
+    g.NextItemStaticID = NULL;
+    return ret;
+}
+#endif
+
 bool ImGui::SliderFloat2(const char* label, float v[2], float v_min, float v_max, const char* format, ImGuiSliderFlags flags)
 {
     return SliderScalarN(label, ImGuiDataType_Float, v, 2, &v_min, &v_max, format, flags);
@@ -3103,6 +3299,17 @@ bool ImGui::SliderInt(const char* label, int* v, int v_min, int v_max, const cha
     return SliderScalar(label, ImGuiDataType_S32, v, &v_min, &v_max, format, flags);
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+bool ImGui::SliderInt(ImGuiStaticID& label, int* v, int v_min, int v_max, const char* format, ImGuiSliderFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &label;
+    bool ret = SliderScalar(label.Label, ImGuiDataType_S32, v, &v_min, &v_max, format, flags);
+    g.NextItemStaticID = NULL;
+    return ret;
+}
+#endif
+
 bool ImGui::SliderInt2(const char* label, int v[2], int v_min, int v_max, const char* format, ImGuiSliderFlags flags)
 {
     return SliderScalarN(label, ImGuiDataType_S32, v, 2, &v_min, &v_max, format, flags);
@@ -6089,6 +6296,17 @@ bool ImGui::CollapsingHeader(const char* label, ImGuiTreeNodeFlags flags)
     return TreeNodeBehavior(window->GetID(label), flags | ImGuiTreeNodeFlags_CollapsingHeader, label);
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+bool ImGui::CollapsingHeader(ImGuiStaticID& label, ImGuiTreeNodeFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    return TreeNodeBehavior(window->GetID(label), flags | ImGuiTreeNodeFlags_CollapsingHeader, label.Label);
+}
+#endif
+
 // p_visible == NULL                        : regular collapsing header
 // p_visible != NULL && *p_visible == true  : show a small close button on the corner of the header, clicking the button will set *p_visible = false
 // p_visible != NULL && *p_visible == false : do not show the header at all
@@ -6281,6 +6499,17 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     return pressed; //-V1020
 }
 
+#ifdef IMGUI_HAS_STATIC_ID
+bool ImGui::Selectable(ImGuiStaticID& label, bool selected, ImGuiSelectableFlags flags, const ImVec2& size_arg)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemStaticID = &label;
+    bool ret = Selectable(label.Label, selected, flags, size_arg);
+    g.NextItemStaticID = NULL;
+    return ret;
+}
+#endif
+
 bool ImGui::Selectable(const char* label, bool* p_selected, ImGuiSelectableFlags flags, const ImVec2& size_arg)
 {
     if (Selectable(label, *p_selected, flags, size_arg))
@@ -0,0 +1,238 @@
+#include "ImGuiAutocomplete.h"
+#include "ImGuiTableSorter.h"
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+// ASCII lowercase, other bytes (UTF-8 included) compare as they are
+static inline unsigned char foldChar(char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : (unsigned char)c;
+}
+
+static inline bool isLower(char c) { return c >= 'a' && c <= 'z'; }
+static inline bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+static inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+static inline bool isWordChar(char c) { return isLower(c) || isUpper(c) || isDigit(c) || (unsigned char)c >= 0x80; }
+
+// Whether a word starts at name[i]: "get_PlayerHealth2", "HTTPServer", "System.Collections"
+static bool isWordStart(const char* name, int i) {
+    const char c = name[i];
+    if (!isWordChar(c)) return false;
+    if (i == 0) return true;
+    const char previous = name[i - 1];
+    if (!isWordChar(previous)) return true;
+    if (isUpper(c) && isLower(previous)) return true;
+    if (isUpper(c) && isUpper(previous) && isLower(name[i + 1])) return true;
+    if (isDigit(c) != isDigit(previous)) return true;
+    return false;
+}
+
+// Case-insensitive order of two '\0' terminated suffixes
+static bool suffixLess(const char* lhs, const char* rhs) {
+    for (;; lhs++, rhs++) {
+        const unsigned char a = foldChar(*lhs);
+        const unsigned char b = foldChar(*rhs);
+        if (a != b) return a < b;
+        if (a == 0) return false;
+    }
+}
+
+// Build the suffix array, the scores and the segment tree. Returns early (incomplete) once 'cancelled' is true
+void ImGuiAutocomplete::Index::build(const std::vector<std::string>& entries, const std::vector<int>& priorities, const std::function<bool()>& cancelled) {
+    size_t textSize = 0;
+    for (const std::string& entry : entries)
+        textSize += entry.size() + 1;
+    text.reserve(textSize);
+    entryStarts.reserve(entries.size());
+    for (const std::string& entry : entries) {
+        entryStarts.push_back((int)text.size());
+        text.append(entry.c_str(), strlen(entry.c_str()));
+        text.push_back('\0');
+    }
+
+    const char* base = text.c_str();
+    for (int start : entryStarts) {
+        for (int i = 0; base[start + i]; i++)
+            if (isWordStart(base + start, i))
+                suffixes.push_back(start + i);
+    }
+    if (cancelled()) return;
+
+    ImGuiTableSorter::sortIndices(suffixes, [base](int lhs, int rhs) {
+        return suffixLess(base + lhs, base + rhs);
+    }, cancelled);
+    if (cancelled()) return;
+
+    // Priority, then match at the start of the entry, then shorter entries
+    const int count = (int)suffixes.size();
+    scores.resize(count);
+    for (int n = 0; n < count; n++) {
+        const int entry = findEntry(suffixes[n]);
+        const int start = entryStarts[entry];
+        const int length = (int)strlen(base + start);
+        const int priority = entry < (int)priorities.size() ? std::max(0, std::min(priorities[entry], 255)) : 0;
+        scores[n] = ((uint32_t)priority << 24)
+                  | ((suffixes[n] == start ? 1u : 0u) << 23)
+                  | (uint32_t)(0x7FFFFF - std::min(length, 0x7FFFFF));
+    }
+
+    bestTree.resize(count * 2);
+    for (int n = 0; n < count; n++)
+        bestTree[count + n] = n;
+    for (int n = count - 1; n > 0; n--)
+        bestTree[n] = better(bestTree[n * 2], bestTree[n * 2 + 1]) ? bestTree[n * 2] : bestTree[n * 2 + 1];
+}
+
+// Entry containing a text offset
+int ImGuiAutocomplete::Index::findEntry(int position) const {
+    return (int)(std::upper_bound(entryStarts.begin(), entryStarts.end(), position) - entryStarts.begin()) - 1;
+}
+
+// Higher score first, then suffix order (alphabetical) for equal scores
+bool ImGuiAutocomplete::Index::better(int lhs, int rhs) const {
+    return scores[lhs] != scores[rhs] ? scores[lhs] > scores[rhs] : lhs < rhs;
+}
+
+// Suffix with the best score in [begin, end), which must not be empty
+int ImGuiAutocomplete::Index::findBest(int begin, int end) const {
+    const int count = (int)suffixes.size();
+    int best = begin;
+    for (int lo = begin + count, hi = end + count; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1) { if (better(bestTree[lo], best)) best = bestTree[lo]; lo++; }
+        if (hi & 1) { hi--; if (better(bestTree[hi], best)) best = bestTree[hi]; }
+    }
+    return best;
+}
+
+// Constructor
+ImGuiAutocomplete::ImGuiAutocomplete()
+    : m_shared(std::make_shared<Shared>())
+    , m_currentGeneration(0)
+    , m_maxResults(0)
+{
+    m_shared->generation = 0;
+}
+
+// Destructor: cancel the build in flight without waiting for it, it only references m_shared
+ImGuiAutocomplete::~ImGuiAutocomplete() {
+    m_shared->generation++;
+}
+
+// Queue a build on the pool, a newer call cancels it
+void ImGuiAutocomplete::setEntries(std::vector<std::string> entries, std::vector<int> priorities) {
+    const int generation = ++m_shared->generation;
+    auto input = std::make_shared<std::pair<std::vector<std::string>, std::vector<int>>>(std::move(entries), std::move(priorities));
+    std::shared_ptr<Shared> shared = m_shared;
+    ImGuiWorkerPool::getInstance().submit([shared, generation, input] {
+        auto cancelled = [&shared, generation] { return shared->generation.load() != generation; };
+        std::shared_ptr<Index> index;
+        if (!cancelled()) {
+            index = std::make_shared<Index>();
+            index->generation = generation;
+            index->build(input->first, input->second, cancelled);
+        }
+
+        // Checked and published under the lock, a newer build publishes after this one
+        std::lock_guard<std::mutex> lock(shared->publishMutex);
+        if (index && !cancelled())
+            std::atomic_store(&shared->published, std::shared_ptr<const Index>(index));
+    });
+}
+
+// Narrow a range matching 'depth' characters to the suffixes whose next character is 'c'
+void ImGuiAutocomplete::narrow(const Index& index, Range& range, int depth, char c) const {
+    const char* base = index.text.c_str();
+    const unsigned char folded = foldChar(c);
+    const int* first = index.suffixes.data() + range.begin;
+    const int* last = index.suffixes.data() + range.end;
+    first = std::lower_bound(first, last, folded, [base, depth](int suffix, unsigned char value) {
+        return foldChar(base[suffix + depth]) < value;
+    });
+    last = std::upper_bound(first, last, folded, [base, depth](unsigned char value, int suffix) {
+        return value < foldChar(base[suffix + depth]);
+    });
+    range.begin = (int)(first - index.suffixes.data());
+    range.end = (int)(last - index.suffixes.data());
+}
+
+// Binary search of the suffix range, then best-first walk of the segment tree: O(length * log N + K * log N)
+const std::vector<ImGuiAutocomplete::Match>& ImGuiAutocomplete::query(const char* text, int maxResults) {
+    std::shared_ptr<const Index> published = std::atomic_load(&m_shared->published);
+    if (published && published != m_current) {
+        m_current = published;
+        m_currentGeneration = published->generation;
+        m_query.clear();
+        m_ranges.clear();
+        m_maxResults = -1;
+    }
+
+    std::string folded(text ? text : "");
+    for (char& c : folded)
+        c = (char)foldChar(c);
+    if (folded == m_query && maxResults == m_maxResults && !m_ranges.empty())
+        return m_results;
+    m_results.clear();
+    m_maxResults = maxResults;
+    if (!m_current || folded.empty() || maxResults <= 0) {
+        m_query.clear();
+        m_ranges.clear();
+        return m_results;
+    }
+    const Index& index = *m_current;
+
+    // Keep the ranges of the prefix shared with the previous query, narrow from there
+    size_t common = 0;
+    while (common < folded.size() && common < m_query.size() && folded[common] == m_query[common])
+        common++;
+    if (m_ranges.empty())
+        m_ranges.push_back(Range{0, (int)index.suffixes.size()});
+    m_ranges.resize(std::min(m_ranges.size(), common + 1));
+    for (size_t depth = m_ranges.size() - 1; depth < folded.size(); depth++) {
+        Range range = m_ranges.back();
+        if (range.begin < range.end)
+            narrow(index, range, (int)depth, folded[depth]);
+        m_ranges.push_back(range);
+    }
+    m_query = folded;
+
+    const Range range = m_ranges.back();
+    if (range.begin >= range.end)
+        return m_results;
+
+    // Best suffix of each pending sub-range, an entry with several matching words is only reported once
+    struct Candidate {
+        int best;
+        int begin;
+        int end;
+    };
+    auto worse = [&index](const Candidate& lhs, const Candidate& rhs) { return index.better(rhs.best, lhs.best); };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(worse)> candidates(worse);
+    candidates.push(Candidate{index.findBest(range.begin, range.end), range.begin, range.end});
+    while (!candidates.empty() && (int)m_results.size() < maxResults) {
+        const Candidate candidate = candidates.top();
+        candidates.pop();
+        const int position = index.suffixes[candidate.best];
+        const int entry = index.findEntry(position);
+        const bool seen = std::any_of(m_results.begin(), m_results.end(), [entry](const Match& match) { return match.entry == entry; });
+        if (!seen)
+            m_results.push_back(Match{entry, position - index.entryStarts[entry]});
+        if (candidate.begin < candidate.best)
+            candidates.push(Candidate{index.findBest(candidate.begin, candidate.best), candidate.begin, candidate.best});
+        if (candidate.best + 1 < candidate.end)
+            candidates.push(Candidate{index.findBest(candidate.best + 1, candidate.end), candidate.best + 1, candidate.end});
+    }
+    return m_results;
+}
+
+int ImGuiAutocomplete::getEntryCount() const {
+    return m_current ? (int)m_current->entryStarts.size() : 0;
+}
+
+const char* ImGuiAutocomplete::getEntry(int entry) const {
+    return m_current->text.c_str() + m_current->entryStarts[entry];
+}
+
+// Until query() swaps the new index in
+bool ImGuiAutocomplete::isBuilding() const {
+    return m_currentGeneration != m_shared->generation.load();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Autocomplete index for large name lists (class, method and field names)
+ * A query matches the start of any word of an entry, case-insensitively: "hea" finds "Health", "get_Health" and
+ * "PlayerHealthBar" (words split on camelCase, digits and separators like '_', '.', ':').
+ * This is word-start matching, not a substring search: "ealth" or "roid" match nothing ("Android" is one word), unlike
+ * the std::string::find filter DrawAutocompleteExamples used before. Each word of a name is indexed, not each character.
+ * The index is a suffix array restricted to word starts, built on ImGuiWorkerPool, plus a max segment tree over the
+ * suffix scores: a query is a binary search for its suffix range and a top-K walk of the tree, independent of the
+ * number of matches. Typing one more character only narrows the previous range, deleting one reuses the shorter one.
+ * Results are ranked by priority, then matches at the start of the entry, then shorter entries.
+ * Usage:
+ *   autocomplete.setEntries(std::move(names));        // Once, or when the names change
+ *   for (const ImGuiAutocomplete::Match& match : autocomplete.query(input.c_str(), 20))
+ *       ImGui::Selectable(autocomplete.getEntry(match.entry));
+ */
+class ImGuiAutocomplete {
+public:
+    struct Match {
+        int entry;      // Index in the entries passed to setEntries()
+        int offset;     // Byte offset of the matched word in the entry
+    };
+
+    ImGuiAutocomplete();
+    ~ImGuiAutocomplete();
+
+    // Replace the entries and build their index on ImGuiWorkerPool. The previous entries keep answering queries
+    // until the new index is ready. 'priorities' (0 - 255, higher first) is optional, one per entry
+    void setEntries(std::vector<std::string> entries, std::vector<int> priorities = std::vector<int>());
+
+    // Best 'maxResults' matches of 'text', each entry at most once. Empty for an empty text.
+    // Picks up a finished index. The result stays valid until the next call
+    const std::vector<Match>& query(const char* text, int maxResults);
+
+    // Entries of the index used by the last query()
+    int getEntryCount() const;
+    const char* getEntry(int entry) const;
+
+    // Whether an index is being built
+    bool isBuilding() const;
+
+private:
+    // Disable copy constructor and assignment
+    ImGuiAutocomplete(const ImGuiAutocomplete&) = delete;
+    ImGuiAutocomplete& operator=(const ImGuiAutocomplete&) = delete;
+
+    // Immutable once published
+    struct Index {
+        int generation;
+        std::string text;                   // Entries, each followed by '\0'
+        std::vector<int> entryStarts;       // Offset of each entry in 'text'
+        std::vector<int> suffixes;          // Offsets of word starts in 'text', sorted case-insensitively
+        std::vector<uint32_t> scores;       // Rank of each suffix, higher first
+        std::vector<int> bestTree;          // Segment tree over 'suffixes': index of the best score, 2 * count nodes
+
+        void build(const std::vector<std::string>& entries, const std::vector<int>& priorities, const std::function<bool()>& cancelled);
+        int findEntry(int position) const;
+        int findBest(int begin, int end) const;
+        bool better(int lhs, int rhs) const;
+    };
+
+    // Suffix range [begin, end) matching the first n characters of the query
+    struct Range {
+        int begin;
+        int end;
+    };
+
+    void narrow(const Index& index, Range& range, int depth, char c) const;
+
+    // State shared with the builds in flight. They hold a reference to it, so the destructor only cancels them and
+    // never waits: it can run during static destruction, when the pool threads may already be gone
+    struct Shared {
+        std::atomic<int> generation;
+        std::mutex publishMutex;
+        std::shared_ptr<const Index> published;     // Written by the pool with std::atomic_store()
+    };
+
+    std::shared_ptr<Shared> m_shared;
+    std::shared_ptr<const Index> m_current;         // Index used by the UI
+    int m_currentGeneration;
+
+    // Last query, for incremental narrowing and for repeated queries
+    std::string m_query;                // Lowercase
+    std::vector<Range> m_ranges;        // m_ranges[n] matches the first n characters of m_query
+    int m_maxResults;
+    std::vector<Match> m_results;
+};
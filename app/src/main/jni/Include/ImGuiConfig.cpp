@@ -0,0 +1,640 @@
+#include "ImGuiConfig.h"
+#include "ArenaJson.h"
+#include "ImGui/imgui_internal.h"
+#include <algorithm>
+#include <android/log.h>
+#include <cstring>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+
+#define LOG_TAG "ImGuiConfig"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// Entry holding the ImGui window layout (ImGui::SaveIniSettingsToMemory())
+static const char* LAYOUT_KEY = "imgui.layout";
+
+// Context.getFilesDir(), set from a JVM thread by setFilesDir() and read by the render thread
+static std::mutex s_filesDirMutex;
+static std::string s_filesDir;
+
+// Arena chunks: a parsed document or a save fits in one or a few, a value decoded by loadValue() in one
+static const size_t DOCUMENT_CHUNK_SIZE = 256 << 10;
+static const size_t DECODE_CHUNK_SIZE = 16 << 10;
+
+// Big-endian unsigned integer of 1, 2, 4 or 8 bytes
+static uint64_t readBigEndian(const uint8_t* p, int bytes) {
+    uint64_t value = 0;
+    for (int n = 0; n < bytes; n++)
+        value = (value << 8) | p[n];
+    return value;
+}
+
+// One MessagePack item: bytes of its header and of its payload, number of items nested in it. False if malformed
+static bool readMsgpackHeader(const uint8_t* p, const uint8_t* end, size_t& headerSize, uint64_t& payloadSize, uint64_t& children) {
+    if (p >= end) return false;
+    const uint8_t type = *p;
+    const size_t available = (size_t)(end - p);
+    headerSize = 1;
+    payloadSize = 0;
+    children = 0;
+    int lengthBytes = 0;
+    if (type <= 0x7f || type >= 0xe0 || type == 0xc0 || type == 0xc2 || type == 0xc3) {
+        // Fixint, nil, bool
+    } else if (type <= 0x8f) {
+        children = (uint64_t)(type & 0x0f) * 2;
+    } else if (type <= 0x9f) {
+        children = type & 0x0f;
+    } else if (type <= 0xbf) {
+        payloadSize = type & 0x1f;
+    } else {
+        switch (type) {
+        case 0xc4: case 0xd9: lengthBytes = 1; break;                       // bin8, str8
+        case 0xc5: case 0xda: lengthBytes = 2; break;                       // bin16, str16
+        case 0xc6: case 0xdb: lengthBytes = 4; break;                       // bin32, str32
+        case 0xc7: lengthBytes = 1; payloadSize = 1; break;                 // ext8 (+ type byte)
+        case 0xc8: lengthBytes = 2; payloadSize = 1; break;                 // ext16
+        case 0xc9: lengthBytes = 4; payloadSize = 1; break;                 // ext32
+        case 0xca: case 0xce: case 0xd2: payloadSize = 4; break;            // float32, uint32, int32
+        case 0xcb: case 0xcf: case 0xd3: payloadSize = 8; break;            // float64, uint64, int64
+        case 0xcc: case 0xd0: payloadSize = 1; break;                       // uint8, int8
+        case 0xcd: case 0xd1: payloadSize = 2; break;                       // uint16, int16
+        case 0xd4: payloadSize = 2; break;                                  // fixext1 .. fixext16
+        case 0xd5: payloadSize = 3; break;
+        case 0xd6: payloadSize = 5; break;
+        case 0xd7: payloadSize = 9; break;
+        case 0xd8: payloadSize = 17; break;
+        case 0xdc: case 0xde: lengthBytes = 2; break;                       // array16, map16
+        case 0xdd: case 0xdf: lengthBytes = 4; break;                       // array32, map32
+        default: return false;                                              // 0xc1 is never used
+        }
+        if (available < 1 + (size_t)lengthBytes) return false;
+        const uint64_t length = readBigEndian(p + 1, lengthBytes);
+        headerSize += lengthBytes;
+        if (type >= 0xdc && type <= 0xdf)
+            children = type >= 0xde ? length * 2 : length;
+        else if (lengthBytes)
+            payloadSize += length;
+    }
+    return payloadSize <= available - headerSize;
+}
+
+// End of the MessagePack item at 'p' and everything nested in it, NULL if malformed. Iterative, nesting costs no stack
+static const uint8_t* skipMsgpack(const uint8_t* p, const uint8_t* end) {
+    uint64_t pending = 1;
+    while (pending > 0) {
+        size_t headerSize;
+        uint64_t payloadSize, children;
+        if (!readMsgpackHeader(p, end, headerSize, payloadSize, children)) return nullptr;
+        p += headerSize + payloadSize;
+        pending += children - 1;
+    }
+    return p;
+}
+
+// MessagePack map header for 'count' pairs
+static void writeMsgpackMapHeader(std::string& out, size_t count) {
+    if (count <= 15) {
+        out.push_back((char)(0x80 | count));
+    } else if (count <= 0xffff) {
+        out.push_back((char)0xde);
+        out.push_back((char)(count >> 8));
+        out.push_back((char)count);
+    } else {
+        out.push_back((char)0xdf);
+        for (int shift = 24; shift >= 0; shift -= 8)
+            out.push_back((char)(count >> shift));
+    }
+}
+
+static bool isMsgpackPath(const std::string& path) {
+    static const char extension[] = ".msgpack";
+    const size_t length = sizeof(extension) - 1;
+    return path.size() >= length && path.compare(path.size() - length, length, extension) == 0;
+}
+
+struct ImGuiConfig::Document {
+    // JSON file: the parsed object, null otherwise. Its values are in 'arena'
+    MonotonicArena arena{DOCUMENT_CHUNK_SIZE};
+    ArenaJson json;
+
+    // MessagePack file: mapping and top-level pairs, in file order
+    struct Item {
+        std::string_view key;
+        const uint8_t* begin;           // Key header
+        const uint8_t* value;
+        const uint8_t* end;
+    };
+    const uint8_t* mapped = nullptr;
+    size_t mappedSize = 0;
+    std::vector<Item> items;
+    std::unordered_map<std::string_view, int> index;
+
+    ~Document() {
+        {
+            MonotonicArena::Scope scope(arena);
+            json = nullptr;
+        }
+        if (mapped) munmap((void*)mapped, mappedSize);
+    }
+
+    // Record where each top-level value is, without decoding any of them
+    bool indexMapping() {
+        const uint8_t* p = mapped;
+        const uint8_t* end = mapped + mappedSize;
+        size_t headerSize;
+        uint64_t payloadSize, children;
+        if (!readMsgpackHeader(p, end, headerSize, payloadSize, children) || (*p != 0xde && *p != 0xdf && (*p & 0xf0) != 0x80))
+            return false;
+        p += headerSize;
+        const uint64_t count = children / 2;
+        items.reserve((size_t)std::min<uint64_t>(count, mappedSize));
+        index.reserve(items.capacity());
+        for (uint64_t n = 0; n < count; n++) {
+            Item item;
+            item.begin = p;
+            // Keys must be strings (fixstr, str8, str16, str32)
+            if (!readMsgpackHeader(p, end, headerSize, payloadSize, children))
+                return false;
+            if (!((*p >= 0xa0 && *p <= 0xbf) || *p == 0xd9 || *p == 0xda || *p == 0xdb))
+                return false;
+            item.key = std::string_view((const char*)p + headerSize, (size_t)payloadSize);
+            item.value = p + headerSize + payloadSize;
+            item.end = skipMsgpack(item.value, end);
+            if (!item.end) return false;
+            index[item.key] = (int)items.size();
+            items.push_back(item);
+            p = item.end;
+        }
+        return true;
+    }
+
+    // Value of a top-level key, NULL if there is none. MessagePack values are decoded into 'decoded'
+    const ArenaJson* find(const std::string& key, ArenaJson& decoded) const {
+        if (!mapped) {
+            auto it = json.find(key);
+            return it != json.end() ? &*it : nullptr;
+        }
+        auto it = index.find(key);
+        if (it == index.end()) return nullptr;
+        const Item& item = items[it->second];
+        decoded = ArenaJson::from_msgpack(item.value, item.end, true, false);
+        return decoded.is_discarded() ? nullptr : &decoded;
+    }
+
+    // Whole document, for conversions and JSON saves of a MessagePack file
+    ArenaJson toJson() const {
+        if (!mapped) return json;
+        ArenaJson result = ArenaJson::object();
+        for (const Item& item : items)
+            result[std::string(item.key)] = ArenaJson::from_msgpack(item.value, item.end, true, false);
+        return result;
+    }
+};
+
+// Constructor
+ImGuiConfig::ImGuiConfig()
+    : m_saveDelay(1.0f)
+    , m_maxSaveDelay(10.0f)
+    , m_decodeArena(DECODE_CHUNK_SIZE)
+    , m_writeArena(DOCUMENT_CHUNK_SIZE)
+    , m_binary(false)
+    , m_document(new Document())
+    , m_flushRequested(false)
+    , m_queuedCount(0)
+    , m_writtenCount(0)
+    , m_quit(false)
+{
+}
+
+// Destructor, the writer writes the pending save first
+ImGuiConfig::~ImGuiConfig() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_condition.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+// Get singleton instance
+ImGuiConfig& ImGuiConfig::getInstance() {
+    static ImGuiConfig instance;
+    return instance;
+}
+
+// <Context.getFilesDir()>/modmenu_config.json
+std::string ImGuiConfig::getDefaultPath() {
+    std::lock_guard<std::mutex> lock(s_filesDirMutex);
+    if (s_filesDir.empty()) {
+        LOGE("App files directory unknown, call setFilesDir() first");
+        return std::string();
+    }
+    return s_filesDir + "/modmenu_config.json";
+}
+
+// Context.getFilesDir().getAbsolutePath() of the Application. Each call returns null once an exception is pending
+// (class or method missing, no application yet), which is cleared and leaves the directory unset
+bool ImGuiConfig::setFilesDir(JNIEnv* env) {
+    if (env->PushLocalFrame(8) != JNI_OK) return false;
+
+    jclass activityThreadClass = env->FindClass("android/app/ActivityThread");
+    jmethodID currentApplication = activityThreadClass ? env->GetStaticMethodID(activityThreadClass, "currentApplication", "()Landroid/app/Application;") : nullptr;
+    jobject application = currentApplication ? env->CallStaticObjectMethod(activityThreadClass, currentApplication) : nullptr;
+    jclass contextClass = application ? env->FindClass("android/content/Context") : nullptr;
+    jmethodID getFilesDir = contextClass ? env->GetMethodID(contextClass, "getFilesDir", "()Ljava/io/File;") : nullptr;
+    jobject filesDir = getFilesDir ? env->CallObjectMethod(application, getFilesDir) : nullptr;
+    jclass fileClass = filesDir ? env->FindClass("java/io/File") : nullptr;
+    jmethodID getAbsolutePath = fileClass ? env->GetMethodID(fileClass, "getAbsolutePath", "()Ljava/lang/String;") : nullptr;
+    jstring path = getAbsolutePath ? (jstring)env->CallObjectMethod(filesDir, getAbsolutePath) : nullptr;
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        path = nullptr;
+    }
+
+    if (path) {
+        const char* chars = env->GetStringUTFChars(path, nullptr);
+        LOGI("App files directory: %s", chars);
+        std::lock_guard<std::mutex> lock(s_filesDirMutex);
+        s_filesDir = chars;
+        env->ReleaseStringUTFChars(path, chars);
+    }
+    env->PopLocalFrame(nullptr);
+    return path != nullptr;
+}
+
+// Map the file. MessagePack keeps the mapping and indexes it, JSON is parsed into the document arena and unmapped.
+// False if missing or invalid
+bool ImGuiConfig::readDocument(const char* path, Document& document) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size > 0)
+        mapping = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    const uint8_t* data = (const uint8_t*)mapping;
+    const size_t size = (size_t)status.st_size;
+    if ((data[0] & 0xf0) == 0x80 || data[0] == 0xde || data[0] == 0xdf) {
+        document.mapped = data;
+        document.mappedSize = size;
+        if (document.indexMapping()) return true;
+        document.items.clear();
+        document.index.clear();
+        document.mapped = nullptr;
+    } else {
+        // No exceptions: an invalid file gives a discarded value
+        MonotonicArena::Scope scope(document.arena);
+        ArenaJson json = ArenaJson::parse(data, data + size, nullptr, false);
+        if (json.is_object()) {
+            document.json = std::move(json);
+            munmap(mapping, size);
+            return true;
+        }
+    }
+    document.arena.reset();
+    munmap(mapping, size);
+    return false;
+}
+
+bool ImGuiConfig::load(const char* path) {
+    if (m_thread.joinable()) return false;
+    m_path = path;
+
+    const bool loaded = readDocument(path, *m_document);
+    if (!loaded && access(path, F_OK) == 0)
+        LOGW("Ignoring invalid config file %s", path);
+    // Saves keep the form of the file, a new file is MessagePack if its name says so
+    m_binary = loaded ? m_document->mapped != nullptr : isMsgpackPath(m_path);
+
+    // Entries created before load() pick up the loaded values
+    for (Entry& entry : m_entries)
+        loadValue(entry);
+
+    if (ImGui::GetCurrentContext()) {
+        const std::string& layout = getString(LAYOUT_KEY);
+        if (!layout.empty())
+            ImGui::LoadIniSettingsFromMemory(layout.c_str(), layout.size());
+    }
+    applyIniSavingRate();
+
+    m_thread = std::thread(&ImGuiConfig::writerLoop, this);
+    LOGI("Config %s: %s", loaded ? "loaded" : "created", path);
+    return loaded;
+}
+
+// Find or create an entry. A new entry, or one used with another type, starts with the default value
+ImGuiConfig::Entry& ImGuiConfig::getEntry(const char* key, Type type, Value defaultValue, const char* defaultText) {
+    // Hash collisions are resolved by rehashing with the previous hash as seed
+    ImGuiID id = ImHashStr(key);
+    Entry* entry = nullptr;
+    for (;;) {
+        auto it = m_index.find(id);
+        if (it == m_index.end()) break;
+        if (m_entries[it->second].key == key) {
+            entry = &m_entries[it->second];
+            if (entry->type == type) return *entry;
+            LOGW("Config key %s used with another type, reset", key);
+            break;
+        }
+        id = ImHashStr(key, 0, id + 1);
+    }
+    if (!entry) {
+        m_index[id] = (int)m_entries.size();
+        m_entries.emplace_back();
+        entry = &m_entries.back();
+        entry->key = key;
+    }
+
+    entry->type = type;
+    entry->value = defaultValue;
+    entry->text = defaultText;
+    loadValue(*entry);
+    return *entry;
+}
+
+// Take the loaded value of an entry if it has the entry type. Not a change to save
+void ImGuiConfig::loadValue(Entry& entry) {
+    {
+        // A decoded MessagePack value lives until the end of the block, its arena is reused by the next entry
+        MonotonicArena::Scope scope(m_decodeArena);
+        ArenaJson decoded;
+        const ArenaJson* loaded = m_document->find(entry.key, decoded);
+        if (loaded) {
+            switch (entry.type) {
+            case TypeBool:
+                if (loaded->is_boolean()) entry.value.b = loaded->get<bool>();
+                break;
+            case TypeInt:
+                if (loaded->is_number_integer()) entry.value.i = loaded->get<int>();
+                break;
+            case TypeFloat:
+                if (loaded->is_number()) entry.value.f = loaded->get<float>();
+                break;
+            case TypeString:
+                if (loaded->is_string()) entry.text = loaded->get<std::string>();
+                break;
+            }
+        }
+    }
+    m_decodeArena.reset();
+    entry.saved = entry.value;
+    entry.savedText = entry.text;
+}
+
+bool& ImGuiConfig::getBool(const char* key, bool defaultValue) {
+    Value value = {};
+    value.b = defaultValue;
+    return getEntry(key, TypeBool, value, "").value.b;
+}
+
+int& ImGuiConfig::getInt(const char* key, int defaultValue) {
+    Value value = {};
+    value.i = defaultValue;
+    return getEntry(key, TypeInt, value, "").value.i;
+}
+
+float& ImGuiConfig::getFloat(const char* key, float defaultValue) {
+    Value value = {};
+    value.f = defaultValue;
+    return getEntry(key, TypeFloat, value, "").value.f;
+}
+
+std::string& ImGuiConfig::getString(const char* key, const char* defaultValue) {
+    return getEntry(key, TypeString, Value(), defaultValue).text;
+}
+
+void ImGuiConfig::setSaveDelay(float seconds, float maxSeconds) {
+    m_saveDelay = seconds;
+    m_maxSaveDelay = maxSeconds;
+    applyIniSavingRate();
+}
+
+// ImGui flags a layout change after io.IniSavingRate, 5 seconds by default: a layout flagged later than the values
+// would miss a save made on pause
+void ImGuiConfig::applyIniSavingRate() {
+    if (ImGui::GetCurrentContext())
+        ImGui::GetIO().IniSavingRate = m_saveDelay;
+}
+
+// Compare the values with the last snapshot (bitwise, so NaN is stable), true if any changed
+bool ImGuiConfig::takeChanges() {
+    bool changed = false;
+    for (Entry& entry : m_entries) {
+        bool same;
+        switch (entry.type) {
+        case TypeBool:   same = entry.value.b == entry.saved.b; break;
+        case TypeInt:    same = entry.value.i == entry.saved.i; break;
+        case TypeFloat:  same = memcmp(&entry.value.f, &entry.saved.f, sizeof(float)) == 0; break;
+        default:         same = entry.text == entry.savedText; break;
+        }
+        if (same) continue;
+        entry.saved = entry.value;
+        entry.savedText = entry.text;
+        changed = true;
+    }
+    return changed;
+}
+
+// A few hundred entries, the comparison costs less than a widget
+void ImGuiConfig::update() {
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.WantSaveIniSettings) {
+        getString(LAYOUT_KEY) = ImGui::SaveIniSettingsToMemory();
+        io.WantSaveIniSettings = false;
+    }
+    if (takeChanges())
+        queueSave();
+}
+
+static std::chrono::steady_clock::duration secondsToDuration(float seconds) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(seconds));
+}
+
+// Copy the values into the snapshot the writer did not start writing yet. It is due once the values stopped changing
+// for the save delay, or the max delay after the first change it has not written. The snapshots are recycled, in
+// the steady state a changing value costs a copy and no allocation
+void ImGuiConfig::queueSave() {
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) return;
+        if (!m_pending) {
+            m_pending = m_spare ? std::move(m_spare) : std::unique_ptr<Snapshot>(new Snapshot());
+            m_pendingSince = now;
+        }
+        m_pending->entries.assign(m_entries.begin(), m_entries.end());
+        m_pendingDue = std::min(now + secondsToDuration(m_saveDelay), m_pendingSince + secondsToDuration(m_maxSaveDelay));
+        m_queuedCount++;
+    }
+    m_condition.notify_one();
+}
+
+void ImGuiConfig::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const int queued = m_queuedCount;
+    if (m_pending) {
+        m_flushRequested = true;
+        m_condition.notify_one();
+    }
+    m_writtenCondition.wait(lock, [this, queued] { return m_writtenCount >= queued || !m_thread.joinable(); });
+}
+
+void ImGuiConfig::requestFlush() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_pending) return;
+        m_flushRequested = true;
+    }
+    m_condition.notify_one();
+}
+
+// Writer thread main loop: writes the pending snapshot once due, or at once for a flush or on quit. Exits once the
+// last snapshot is written
+void ImGuiConfig::writerLoop() {
+    for (;;) {
+        std::unique_ptr<Snapshot> snapshot;
+        int queued;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_pending || !(m_quit || m_flushRequested || std::chrono::steady_clock::now() >= m_pendingDue)) {
+                if (!m_pending && m_quit)
+                    return;
+                if (m_pending)
+                    m_condition.wait_until(lock, m_pendingDue);
+                else
+                    m_condition.wait(lock);
+            }
+            m_flushRequested = false;
+            snapshot = std::move(m_pending);
+            queued = m_queuedCount;
+        }
+
+        std::string data;
+        {
+            // Every JSON value of the save goes in the write arena, dropped at once afterwards
+            MonotonicArena::Scope scope(m_writeArena);
+            data = serialize(*snapshot);
+        }
+        m_writeArena.reset();
+        writeFile(m_path, data);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_writtenCount = queued;
+            m_spare = std::move(snapshot);
+        }
+        m_writtenCondition.notify_all();
+    }
+}
+
+// Values of the snapshot over the loaded document, in the file format. JSON values go in the current arena
+std::string ImGuiConfig::serialize(const Snapshot& snapshot) const {
+    auto toJson = [](const Entry& entry) -> ArenaJson {
+        switch (entry.type) {
+        case TypeBool:   return entry.value.b;
+        case TypeInt:    return entry.value.i;
+        case TypeFloat:  return entry.value.f;
+        default:         return entry.text;
+        }
+    };
+
+    if (!m_binary) {
+        ArenaJson json = m_document->toJson();
+        for (const Entry& entry : snapshot.entries)
+            json[entry.key] = toJson(entry);
+        return json.dump(1, '\t', false, ArenaJson::error_handler_t::replace);
+    }
+
+    // Loaded pairs the snapshot does not replace are kept as they are: raw bytes when the file was MessagePack
+    std::unordered_set<std::string_view> replaced;
+    for (const Entry& entry : snapshot.entries)
+        replaced.insert(entry.key);
+    const Document& document = *m_document;
+    size_t kept = 0;
+    if (document.mapped) {
+        for (const Document::Item& item : document.items)
+            kept += replaced.count(item.key) ? 0 : 1;
+    } else {
+        for (auto it = document.json.begin(); it != document.json.end(); ++it)
+            kept += replaced.count(it.key()) ? 0 : 1;
+    }
+
+    std::string data;
+    writeMsgpackMapHeader(data, kept + snapshot.entries.size());
+    if (document.mapped) {
+        for (const Document::Item& item : document.items)
+            if (!replaced.count(item.key))
+                data.append((const char*)item.begin, (size_t)(item.end - item.begin));
+    } else {
+        for (auto it = document.json.begin(); it != document.json.end(); ++it) {
+            if (replaced.count(it.key())) continue;
+            ArenaJson::to_msgpack(ArenaJson(it.key()), data);
+            ArenaJson::to_msgpack(it.value(), data);
+        }
+    }
+    for (const Entry& entry : snapshot.entries) {
+        ArenaJson::to_msgpack(ArenaJson(entry.key), data);
+        ArenaJson::to_msgpack(toJson(entry), data);
+    }
+    return data;
+}
+
+// Write "<path>.tmp", rename it over the file and sync the directory so that the rename itself is on disk
+bool ImGuiConfig::writeFile(const std::string& path, const std::string& data) {
+    const std::string temporary = path + ".tmp";
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOGE("Failed to open %s", temporary.c_str());
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result < 0) break;
+        written += (size_t)result;
+    }
+    // The data must be on disk before the rename makes it the config
+    const bool ok = written == data.size() && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(temporary.c_str(), path.c_str()) != 0) {
+        LOGE("Failed to write %s", path.c_str());
+        unlink(temporary.c_str());
+        return false;
+    }
+    const size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int directoryFd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directoryFd < 0 || fsync(directoryFd) != 0)
+        LOGW("Failed to sync %s", directory.c_str());
+    if (directoryFd >= 0)
+        close(directoryFd);
+    return true;
+}
+
+// Both forms hold the same JSON data model, nothing is lost either way
+bool ImGuiConfig::convertFile(const char* source, const char* destination) {
+    Document document;
+    if (!readDocument(source, document)) {
+        LOGE("Failed to read %s", source);
+        return false;
+    }
+    MonotonicArena arena(DOCUMENT_CHUNK_SIZE);
+    MonotonicArena::Scope scope(arena);
+    const ArenaJson json = document.toJson();
+    std::string data;
+    if (isMsgpackPath(destination))
+        ArenaJson::to_msgpack(json, data);
+    else
+        data = json.dump(1, '\t', false, ArenaJson::error_handler_t::replace);
+    return writeFile(destination, data);
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "ImGui/imgui.h"
+#include "MonotonicArena.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <jni.h>
+
+/**
+ * Persistent menu configuration: toggles, slider values and the ImGui window layout
+ * Values live in a flat typed store owned by the render thread. get*() returns a reference that stays valid for
+ * the life of the store, so widgets edit the value in place and the reference can be cached:
+ *   static bool& godMode = ImGuiConfig::getInstance().getBool("cheats.godMode");
+ *   ImGui::Checkbox("God mode", &godMode);
+ * update() (once per frame) compares the values with the last saved ones and hands the changed ones to a writer thread
+ * right away, the writer waits until they stopped changing for the save delay: dragging a slider writes one file at
+ * the end of the drag and the render thread never touches the disk. Since the writer always has the latest values,
+ * requestFlush() can have them written from any thread without waiting for a frame (Activity.onPause(), when no frame
+ * follows). The writer serializes with nlohmann::json and replaces the file atomically (write to "<path>.tmp", fsync,
+ * rename, fsync the directory), a crash leaves either the old or the new file.
+ * The window layout is picked up when ImGui flags it for saving, io.IniSavingRate is set to the save delay.
+ * It is kept in the "imgui.layout" entry (io.IniFilename stays NULL).
+ * Large presets can use the MessagePack form (detected from the content, new files ending in ".msgpack"): load()
+ * maps the file and only indexes the offsets of its top-level values, a value is decoded the first time its key is
+ * used and the values never used are copied back byte for byte on save. convertFile() turns one form into the other
+ * losslessly for editing.
+ * JSON values (ArenaJson.h) are allocated in arenas: the parsed document in its own, a save in a write arena reset
+ * after each file, so loading or saving costs a few chunk allocations instead of one malloc per value.
+ */
+class ImGuiConfig {
+public:
+    // Singleton instance
+    static ImGuiConfig& getInstance();
+
+    // Read the file (missing or invalid: start empty), apply the window layout and start the writer thread.
+    // Call once after ImGui::CreateContext(), before the first frame
+    bool load(const char* path);
+
+    // Default file: <Context.getFilesDir()>/modmenu_config.json, empty until setFilesDir() succeeded
+    static std::string getDefaultPath();
+
+    // Resolve the app's Context.getFilesDir() for getDefaultPath(), from a thread attached to the JVM (loadJNI()).
+    // The context is the Application returned by ActivityThread.currentApplication()
+    static bool setFilesDir(JNIEnv* env);
+
+    // Register the natives of ImGuiConfigBridge: libModMenu.so is not loaded by the class loader, so ART cannot find
+    // them by name. From loadJNI(), like setFilesDir()
+    static bool registerJNIMethods(JNIEnv* env);
+
+    // Rewrite a config file as JSON or MessagePack, after the extension of 'destination' (".msgpack" or anything else)
+    static bool convertFile(const char* source, const char* destination);
+
+    // Value of a key, created with 'defaultValue' (or the loaded value) on first use. Render thread only
+    bool& getBool(const char* key, bool defaultValue = false);
+    int& getInt(const char* key, int defaultValue = 0);
+    float& getFloat(const char* key, float defaultValue = 0.0f);
+    std::string& getString(const char* key, const char* defaultValue = "");
+
+    // Once per frame after the menu was drawn: pick up value and layout changes and hand them to the writer
+    void update();
+
+    // Have the writer save the changes update() handed over now instead of after the save delay, and wait until they
+    // are on disk. Any thread, the render thread waits for the disk too
+    void flush();
+
+    // Same without waiting, from any thread (Activity.onPause())
+    void requestFlush();
+
+    // Time without changes before a save, and the longest a continuous change may delay it
+    void setSaveDelay(float seconds, float maxSeconds);
+
+private:
+    ImGuiConfig();
+    ~ImGuiConfig();
+
+    // Disable copy constructor and assignment
+    ImGuiConfig(const ImGuiConfig&) = delete;
+    ImGuiConfig& operator=(const ImGuiConfig&) = delete;
+
+    enum Type {
+        TypeBool,
+        TypeInt,
+        TypeFloat,
+        TypeString
+    };
+
+    union Value {
+        bool b;
+        int i;
+        float f;
+    };
+
+    struct Entry {
+        std::string key;
+        Type type;
+        Value value;
+        Value saved;            // Value in the last snapshot
+        std::string text;
+        std::string savedText;
+    };
+
+    // Loaded file (parsed JSON, or mapped MessagePack and its offset index), defined in the .cpp
+    struct Document;
+
+    // Values handed to the writer thread
+    struct Snapshot {
+        std::vector<Entry> entries;
+    };
+
+    Entry& getEntry(const char* key, Type type, Value defaultValue, const char* defaultText);
+    void loadValue(Entry& entry);
+    bool takeChanges();
+    void queueSave();
+    void applyIniSavingRate();
+    void writerLoop();
+    std::string serialize(const Snapshot& snapshot) const;
+
+    static bool readDocument(const char* path, Document& document);
+    static bool writeFile(const std::string& path, const std::string& data);
+
+    // Render thread
+    std::deque<Entry> m_entries;                        // Stable addresses, get*() references point in here
+    std::unordered_map<ImGuiID, int> m_index;           // Hash of the key -> entry
+    float m_saveDelay;
+    float m_maxSaveDelay;
+    MonotonicArena m_decodeArena;                       // Values decoded by loadValue(), reset after each
+
+    // Writer thread
+    MonotonicArena m_writeArena;                        // JSON values of the save being written
+
+    // Shared with the writer thread
+    std::string m_path;
+    bool m_binary;                                      // MessagePack file
+    std::unique_ptr<Document> m_document;               // Read-only after load(), keeps the keys this build does not use
+    std::unique_ptr<Snapshot> m_pending;                // Latest snapshot not written yet, a newer one replaces it
+    std::unique_ptr<Snapshot> m_spare;                  // Last written one, refilled by the next queueSave()
+    std::chrono::steady_clock::time_point m_pendingSince;   // First change not written yet
+    std::chrono::steady_clock::time_point m_pendingDue;     // When the writer writes m_pending
+    bool m_flushRequested;                              // Write m_pending now
+    int m_queuedCount;
+    int m_writtenCount;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_writtenCondition;
+    bool m_quit;
+};
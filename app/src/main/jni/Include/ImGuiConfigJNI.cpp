@@ -0,0 +1,31 @@
+#include "ImGuiConfig.h"
+#include <jni.h>
+#include <android/log.h>
+
+#define LOG_TAG "ImGuiConfigJNI"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// JNI method implementations for ImGuiConfigBridge, registered by ImGuiConfig::registerJNIMethods()
+static void nativeRequestFlush(JNIEnv*, jclass) {
+    ImGuiConfig::getInstance().requestFlush();
+}
+
+// Register JNI methods
+bool ImGuiConfig::registerJNIMethods(JNIEnv* env) {
+    static const JNINativeMethod methods[] = {
+        { "nativeRequestFlush", "()V", (void*)nativeRequestFlush },
+    };
+    jclass bridgeClass = env->FindClass("com/reveny/imgui/mod/ImGuiConfigBridge");
+    if (!bridgeClass) {
+        env->ExceptionClear();
+        LOGE("Failed to find ImGuiConfigBridge class");
+        return false;
+    }
+    const bool registered = env->RegisterNatives(bridgeClass, methods, sizeof(methods) / sizeof(methods[0])) == JNI_OK;
+    env->DeleteLocalRef(bridgeClass);
+    if (!registered) {
+        env->ExceptionClear();
+        LOGE("Failed to register ImGuiConfigBridge natives");
+    }
+    return registered;
+}
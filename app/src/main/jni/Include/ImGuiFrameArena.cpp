@@ -0,0 +1,185 @@
+#include "ImGuiFrameArena.h"
+#include <cstdlib>
+#include <cstring>
+
+// Every block is prefixed with its size class (and its size for large blocks). 16 bytes keep the payload aligned like malloc on arm64.
+struct BlockHeader {
+    int classIndex;
+    size_t size;
+};
+static const size_t BLOCK_HEADER_SIZE = 16;
+static_assert(sizeof(BlockHeader) <= BLOCK_HEADER_SIZE, "BlockHeader must fit in BLOCK_HEADER_SIZE");
+static const int LARGE_BLOCK_CLASS = -1;
+
+// Arena whose free lists the calling thread owns, set by install()
+static thread_local const ImGuiFrameArena* t_ownedArena = nullptr;
+
+// Constructor
+ImGuiFrameArena::ImGuiFrameArena()
+    : m_frameAllocations(0)
+    , m_frameSystemAllocations(0)
+    , m_shrinkFrameCount(0)
+    , m_largeBytesInUse(0)
+{
+    for (SizeClass& sc : m_classes) {
+        sc.freeList = nullptr;
+        sc.cachedCount = 0;
+        sc.peakInUseCount = 0;
+        sc.inUseCount.store(0, std::memory_order_relaxed);
+    }
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+// Get singleton instance
+ImGuiFrameArena& ImGuiFrameArena::getInstance() {
+    static ImGuiFrameArena instance;
+    return instance;
+}
+
+// Route ImGui allocations through the arena
+void ImGuiFrameArena::install() {
+    t_ownedArena = this;
+    ImGui::SetAllocatorFunctions(allocFunc, freeFunc, this);
+}
+
+void* ImGuiFrameArena::allocFunc(size_t size, void* userData) {
+    return static_cast<ImGuiFrameArena*>(userData)->allocate(size);
+}
+
+void ImGuiFrameArena::freeFunc(void* ptr, void* userData) {
+    static_cast<ImGuiFrameArena*>(userData)->release(ptr);
+}
+
+bool ImGuiFrameArena::isRenderThread() const {
+    return t_ownedArena == this;
+}
+
+// Smallest class whose block fits 'size' payload bytes, or LARGE_BLOCK_CLASS.
+// Above 64 bytes each power of two is split in four: 64, 80, 96, 112, 128, 160, 192, 224, 256...
+int ImGuiFrameArena::getSizeClass(size_t size) {
+    size += BLOCK_HEADER_SIZE;
+    if (size <= ((size_t)1 << MIN_CLASS_SHIFT))
+        return 0;
+    if (size > ((size_t)1 << MAX_CLASS_SHIFT))
+        return LARGE_BLOCK_CLASS;
+    // 2^shift <= size - 1 < 2^(shift + 1), the two bits below the top one pick the quarter
+    const size_t last = size - 1;
+    int shift = MIN_CLASS_SHIFT;
+    while ((last >> (shift + 1)) != 0)
+        shift++;
+    const int quarter = (int)((last >> (shift - 2)) & 3);
+    return (shift - MIN_CLASS_SHIFT) * CLASSES_PER_OCTAVE + quarter + 1;
+}
+
+// Block size of a class, header included
+size_t ImGuiFrameArena::getClassSize(int classIndex) {
+    const int octave = classIndex / CLASSES_PER_OCTAVE;
+    const int quarter = classIndex % CLASSES_PER_OCTAVE;
+    const size_t base = (size_t)1 << (MIN_CLASS_SHIFT + octave);
+    return base + (size_t)quarter * (base / CLASSES_PER_OCTAVE);
+}
+
+// Pop a cached block of the right class on the render thread, fall back to malloc
+void* ImGuiFrameArena::allocate(size_t size) {
+    const int classIndex = getSizeClass(size);
+    const bool renderThread = isRenderThread();
+    if (renderThread)
+        m_frameAllocations++;
+
+    char* block;
+    if (classIndex == LARGE_BLOCK_CLASS) {
+        block = (char*)malloc(size + BLOCK_HEADER_SIZE);
+        if (renderThread)
+            m_frameSystemAllocations++;
+        if (block)
+            m_largeBytesInUse.fetch_add(size, std::memory_order_relaxed);
+    } else {
+        SizeClass& sc = m_classes[classIndex];
+        if (renderThread && sc.freeList) {
+            block = (char*)sc.freeList;
+            sc.freeList = sc.freeList->next;
+            sc.cachedCount--;
+        } else {
+            block = (char*)malloc(getClassSize(classIndex));
+            if (renderThread)
+                m_frameSystemAllocations++;
+        }
+        if (block) {
+            const int inUse = sc.inUseCount.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (renderThread && inUse > sc.peakInUseCount)
+                sc.peakInUseCount = inUse;
+        }
+    }
+    if (!block)
+        return nullptr;
+
+    BlockHeader* header = (BlockHeader*)block;
+    header->classIndex = classIndex;
+    header->size = size;
+    return block + BLOCK_HEADER_SIZE;
+}
+
+// Push the block back on its class free list on the render thread. Large blocks, and blocks freed by other threads,
+// go straight back to the system
+void ImGuiFrameArena::release(void* ptr) {
+    if (!ptr) return;
+
+    char* block = (char*)ptr - BLOCK_HEADER_SIZE;
+    const BlockHeader* header = (const BlockHeader*)block;
+    if (header->classIndex == LARGE_BLOCK_CLASS) {
+        m_largeBytesInUse.fetch_sub(header->size, std::memory_order_relaxed);
+        free(block);
+        return;
+    }
+
+    SizeClass& sc = m_classes[header->classIndex];
+    sc.inUseCount.fetch_sub(1, std::memory_order_relaxed);
+    if (!isRenderThread()) {
+        free(block);
+        return;
+    }
+    FreeBlock* freeBlock = (FreeBlock*)block;
+    freeBlock->next = sc.freeList;
+    sc.freeList = freeBlock;
+    sc.cachedCount++;
+}
+
+// Publish counters, and every SHRINK_FRAMES frames trim each free list down to the class high-water mark
+void ImGuiFrameArena::endFrame() {
+    const bool shrink = (++m_shrinkFrameCount >= SHRINK_FRAMES);
+    if (shrink)
+        m_shrinkFrameCount = 0;
+
+    m_stats.frameAllocations = m_frameAllocations;
+    m_stats.frameSystemAllocations = m_frameSystemAllocations;
+    m_stats.bytesInUse = m_largeBytesInUse.load(std::memory_order_relaxed);
+    m_stats.bytesCached = 0;
+    m_frameAllocations = 0;
+    m_frameSystemAllocations = 0;
+
+    for (int n = 0; n < CLASS_COUNT; n++) {
+        SizeClass& sc = m_classes[n];
+        // Blocks allocated by other threads do not update the peak on the way
+        const int inUse = sc.inUseCount.load(std::memory_order_relaxed);
+        if (inUse > sc.peakInUseCount)
+            sc.peakInUseCount = inUse;
+        if (shrink) {
+            // Blocks that were not needed at any point of the window, even at its peak, are surplus
+            while (sc.freeList && inUse + sc.cachedCount > sc.peakInUseCount) {
+                FreeBlock* next = sc.freeList->next;
+                free(sc.freeList);
+                sc.freeList = next;
+                sc.cachedCount--;
+            }
+            sc.peakInUseCount = inUse;
+        }
+        const size_t blockSize = getClassSize(n);
+        m_stats.bytesInUse += (size_t)(inUse > 0 ? inUse : 0) * blockSize;
+        m_stats.bytesCached += (size_t)sc.cachedCount * blockSize;
+    }
+}
+
+// Counters for the last completed frame
+const ImGuiFrameArena::Stats& ImGuiFrameArena::getStats() const {
+    return m_stats;
+}
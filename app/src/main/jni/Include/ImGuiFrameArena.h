@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ImGui/imgui.h"
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Recycling allocator for ImGui, plugged in through ImGui::SetAllocatorFunctions()
+ * Draw list buffers grow through realloc chains (allocate bigger, copy, free smaller) and ImGui
+ * allocates and frees the same block sizes frame after frame. Blocks are rounded up to size classes
+ * (four per power of two, so at most 25% is wasted) and freed blocks are kept in per-class free lists,
+ * so steady state frames never reach malloc. Blocks above 1 << MAX_CLASS_SHIFT always go to malloc.
+ * Cached blocks above the high-water mark of the last SHRINK_FRAMES frames are given back to the system.
+ * The free lists belong to the render thread (the one that called install()) and take no lock. Other
+ * threads allocating through ImGui go straight to malloc/free, only the per-class counters are shared.
+ */
+class ImGuiFrameArena {
+public:
+    // Per-frame counters, published by endFrame()
+    struct Stats {
+        int frameAllocations;       // MemAlloc() calls on the render thread during the last frame
+        int frameSystemAllocations; // Of which had to go to malloc (cache miss or block larger than 1 << MAX_CLASS_SHIFT)
+        size_t bytesInUse;          // Bytes held by ImGui, rounded up to the size class for pooled blocks
+        size_t bytesCached;         // Bytes kept in free lists for reuse
+    };
+
+    // Singleton instance
+    static ImGuiFrameArena& getInstance();
+
+    // Route ImGui allocations through the arena, the calling thread becomes the render thread.
+    // Must be called before ImGui::CreateContext()
+    void install();
+
+    // Apply the shrink policy and publish stats (call once per frame on the render thread, after ImGui_ImplOpenGL3_RenderDrawData)
+    void endFrame();
+
+    // Counters for the last completed frame
+    const Stats& getStats() const;
+
+    static const int MIN_CLASS_SHIFT = 6;           // 64 bytes
+    static const int MAX_CLASS_SHIFT = 20;          // 1 MB, larger blocks always go to malloc
+    static const int CLASSES_PER_OCTAVE = 4;
+    static const int SHRINK_FRAMES = 120;
+
+private:
+    ImGuiFrameArena();
+    ~ImGuiFrameArena() = default;
+
+    // Disable copy constructor and assignment
+    ImGuiFrameArena(const ImGuiFrameArena&) = delete;
+    ImGuiFrameArena& operator=(const ImGuiFrameArena&) = delete;
+
+    static const int CLASS_COUNT = (MAX_CLASS_SHIFT - MIN_CLASS_SHIFT) * CLASSES_PER_OCTAVE + 1;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* freeList;            // Render thread only
+        int cachedCount;                // Render thread only
+        int peakInUseCount;             // High-water mark over the current shrink window, render thread only
+        std::atomic<int> inUseCount;    // Any thread
+    };
+
+    // ImGuiMemAllocFunc / ImGuiMemFreeFunc trampolines
+    static void* allocFunc(size_t size, void* userData);
+    static void freeFunc(void* ptr, void* userData);
+
+    void* allocate(size_t size);
+    void release(void* ptr);
+
+    bool isRenderThread() const;
+    static int getSizeClass(size_t size);
+    static size_t getClassSize(int classIndex);
+
+    SizeClass m_classes[CLASS_COUNT];
+    int m_frameAllocations;
+    int m_frameSystemAllocations;
+    int m_shrinkFrameCount;
+    std::atomic<size_t> m_largeBytesInUse;
+    Stats m_stats;
+};
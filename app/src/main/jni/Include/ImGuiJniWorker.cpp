@@ -0,0 +1,120 @@
+#include "ImGuiJniWorker.h"
+#include <android/log.h>
+#include <pthread.h>
+
+#define LOG_TAG "ImGuiJniWorker"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// Threads attached by getEnv() hold their JavaVM under this key, its destructor detaches them on exit
+static pthread_key_t s_detachKey;
+static pthread_once_t s_detachKeyOnce = PTHREAD_ONCE_INIT;
+
+static void detachThread(void* vm) {
+    ((JavaVM*)vm)->DetachCurrentThread();
+}
+
+static void createDetachKey() {
+    pthread_key_create(&s_detachKey, detachThread);
+}
+
+// Constructor
+ImGuiJniWorker::ImGuiJniWorker()
+    : m_vm(nullptr)
+    , m_running(false)
+    , m_quit(false)
+{
+}
+
+// Destructor
+ImGuiJniWorker::~ImGuiJniWorker() {
+    stop();
+}
+
+// Get singleton instance
+ImGuiJniWorker& ImGuiJniWorker::getInstance() {
+    static ImGuiJniWorker instance;
+    return instance;
+}
+
+void ImGuiJniWorker::start(JavaVM* vm) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running || !vm) return;
+    m_vm = vm;
+    m_quit = false;
+    m_running = true;
+    m_thread = std::thread(&ImGuiJniWorker::workerLoop, this);
+}
+
+void ImGuiJniWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) return;
+        m_quit = true;
+        m_running = false;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+bool ImGuiJniWorker::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) return false;
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+bool ImGuiJniWorker::isRunning() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+// Cached after the first call: GetEnv() and AttachCurrentThread() are only reached once per thread
+JNIEnv* ImGuiJniWorker::getEnv(JavaVM* vm) {
+    static thread_local JNIEnv* t_env = nullptr;
+    if (t_env || !vm) return t_env;
+
+    JNIEnv* env = nullptr;
+    jint result = vm->GetEnv((void**)&env, JNI_VERSION_1_6);
+    if (result == JNI_EDETACHED) {
+        result = vm->AttachCurrentThread(&env, nullptr);
+        if (result != JNI_OK) {
+            LOGE("Failed to attach current thread to JVM");
+            return nullptr;
+        }
+        // Only threads attached here are detached on exit, the others belong to the JVM
+        pthread_once(&s_detachKeyOnce, createDetachKey);
+        pthread_setspecific(s_detachKey, vm);
+    } else if (result != JNI_OK) {
+        return nullptr;
+    }
+    t_env = env;
+    return env;
+}
+
+// Worker thread main loop, attached for its whole life
+void ImGuiJniWorker::workerLoop() {
+    pthread_setname_np(pthread_self(), "ImGuiJniWorker");
+    JNIEnv* env = getEnv(m_vm);
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_quit || !m_tasks.empty(); });
+            if (m_tasks.empty())
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        if (!env) continue;
+        task(env);
+        // A Java exception would make every later JNI call of this thread fail
+        if (env->ExceptionCheck()) {
+            LOGE("Java exception in a posted JNI call");
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+    }
+}
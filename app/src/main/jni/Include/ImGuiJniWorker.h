@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <jni.h>
+
+/**
+ * Thread attached to the JVM once, running JNI calls posted by other threads in order
+ * The render thread posts its Java calls here instead of making them itself, so a busy JVM (GC, a blocked UI thread)
+ * never stalls a frame. Posting only takes a short lock, never one held across a JNI call.
+ */
+class ImGuiJniWorker {
+public:
+    typedef std::function<void(JNIEnv* env)> Task;
+
+    // Singleton instance
+    static ImGuiJniWorker& getInstance();
+
+    // Start the worker thread, attached to 'vm'. Does nothing if it is already running
+    void start(JavaVM* vm);
+
+    // Stop the worker thread once the tasks already posted have run
+    void stop();
+
+    // Queue a task, from any thread. Returns false (and drops the task) when the worker is not running
+    bool post(Task task);
+
+    // Check if the worker thread is running
+    bool isRunning();
+
+    // JNIEnv of the calling thread, cached per thread. Threads attached here are detached when they exit,
+    // they must not be detached by other code meanwhile
+    static JNIEnv* getEnv(JavaVM* vm);
+
+private:
+    ImGuiJniWorker();
+    ~ImGuiJniWorker();
+
+    // Disable copy constructor and assignment
+    ImGuiJniWorker(const ImGuiJniWorker&) = delete;
+    ImGuiJniWorker& operator=(const ImGuiJniWorker&) = delete;
+
+    void workerLoop();
+
+    JavaVM* m_vm;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Task> m_tasks;
+    bool m_running;
+    bool m_quit;
+};
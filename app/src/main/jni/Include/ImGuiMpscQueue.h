@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Bounded multi-producer single-consumer queue over a preallocated ring of Capacity slots (Vyukov's bounded queue)
+ * push() claims a slot with one compare-exchange and fills it in place: no allocation and no lock. The CAS only
+ * retries when another producer claimed the same slot first, a single producer never loops. A full queue makes
+ * push() return false instead of waiting for the consumer.
+ * Popped slots keep their value, so containers in T keep their capacity and filling a slot stops allocating once
+ * they are large enough. front() and pop() must only be called from a single consumer thread.
+ */
+template<typename T, size_t Capacity>
+class ImGuiMpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Constructor
+    ImGuiMpscQueue()
+        : m_enqueuePosition(0)
+        , m_dequeuePosition(0)
+    {
+        for (size_t i = 0; i < Capacity; i++)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Claim the next slot and call fill(T&) on it, from any thread. The slot holds whatever was pushed into it last,
+    // fill has to set every field. Returns false, without calling fill, when the queue is full
+    template<typename Fill>
+    bool push(Fill&& fill) {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[position & (Capacity - 1)];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            if (difference == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    fill(slot.value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // Still holds the element pushed Capacity positions ago
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Oldest element, or nullptr when there is none. From the consumer thread only, valid until pop().
+    // A push that claimed its slot but is still filling it hides the elements after it until it completes
+    T* front() {
+        Slot& slot = m_slots[m_dequeuePosition & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1) return nullptr;
+        return &slot.value;
+    }
+
+    // Hand the oldest element's slot back to the producers, after front() returned it
+    void pop() {
+        Slot& slot = m_slots[m_dequeuePosition & (Capacity - 1)];
+        slot.sequence.store(m_dequeuePosition + Capacity, std::memory_order_release);
+        m_dequeuePosition++;
+    }
+
+    // Check if no element is queued, from the consumer thread only
+    bool empty() {
+        return front() == nullptr;
+    }
+
+private:
+    // Disable copy constructor and assignment
+    ImGuiMpscQueue(const ImGuiMpscQueue&) = delete;
+    ImGuiMpscQueue& operator=(const ImGuiMpscQueue&) = delete;
+
+    // 'sequence' is the position the slot can be pushed at, that position + 1 once filled
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Slot m_slots[Capacity];
+    alignas(64) std::atomic<size_t> m_enqueuePosition;  // Producers
+    alignas(64) size_t m_dequeuePosition;               // Consumer
+};
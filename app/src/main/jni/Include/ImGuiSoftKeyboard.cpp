@@ -1,6 +1,9 @@
 #include "ImGuiSoftKeyboard.h"
+#include "ImGuiJniWorker.h"
+#include "ImGui/imgui_internal.h"
 #include <android/log.h>
 #include <jni.h>
+#include <algorithm>
 #include <cstdarg>
 #include <cstring>
 
@@ -22,10 +25,112 @@ jmethodID ImGuiSoftKeyboard::s_setCursorPositionMethod = nullptr;
 jmethodID ImGuiSoftKeyboard::s_getCursorPositionMethod = nullptr;
 jmethodID ImGuiSoftKeyboard::s_setInputTypeMethod = nullptr;
 jmethodID ImGuiSoftKeyboard::s_setHintMethod = nullptr;
+jmethodID ImGuiSoftKeyboard::s_applySharedEditMethod = nullptr;
+jmethodID ImGuiSoftKeyboard::s_setSharedBuffersMethod = nullptr;
+ImGuiSoftKeyboard::SharedTextChannel ImGuiSoftKeyboard::s_toNative;
+ImGuiSoftKeyboard::SharedTextChannel ImGuiSoftKeyboard::s_toJava;
 
 // Global instance
 ImGuiSoftKeyboard* g_softKeyboard = nullptr;
 
+// Java strings and EditText offsets count UTF-16 units, ImGui works on UTF-8 bytes
+
+// Number of UTF-16 units of a UTF-8 string
+static int utf16Length(const char* text, size_t size) {
+    int length = 0;
+    for (size_t i = 0; i < size; i++) {
+        const unsigned char c = (unsigned char)text[i];
+        if ((c & 0xC0) != 0x80)
+            length += (c >= 0xF0) ? 2 : 1;
+    }
+    return length;
+}
+
+// Byte offset 'units' UTF-16 units after byte 'start', clamped to the end of the text
+static size_t utf8Offset(const std::string& text, size_t start, int units) {
+    size_t offset = start;
+    while (units > 0 && offset < text.size()) {
+        const unsigned char c = (unsigned char)text[offset];
+        const int charSize = (c < 0xC0) ? 1 : (c < 0xE0) ? 2 : (c < 0xF0) ? 3 : 4;
+        units -= (charSize == 4) ? 2 : 1;
+        offset += charSize;
+    }
+    return std::min(offset, text.size());
+}
+
+// Convert as many whole characters as fit in 'capacity' units, returns the unit count. 'size' is updated to the
+// number of bytes converted
+static int copyUtf16(jchar* out, int capacity, const char* text, size_t& size) {
+    int length = 0;
+    size_t i = 0;
+    while (i < size) {
+        const unsigned char c = (unsigned char)text[i];
+        const int charSize = (c < 0xC0) ? 1 : (c < 0xE0) ? 2 : (c < 0xF0) ? 3 : 4;
+        unsigned int codepoint = (charSize == 1) ? c : (c & (0x7F >> charSize));
+        if (i + charSize > size || length + (charSize == 4 ? 2 : 1) > capacity)
+            break;
+        for (int n = 1; n < charSize; n++)
+            codepoint = (codepoint << 6) | (text[i + n] & 0x3F);
+        i += charSize;
+        if (codepoint >= 0x10000) {
+            codepoint -= 0x10000;
+            out[length++] = (jchar)(0xD800 + (codepoint >> 10));
+            out[length++] = (jchar)(0xDC00 + (codepoint & 0x3FF));
+        } else {
+            out[length++] = (jchar)codepoint;
+        }
+    }
+    size = i;
+    return length;
+}
+
+// Unpaired surrogates become U+FFFD
+static void appendUtf8(std::string& out, const jchar* text, int length) {
+    for (int i = 0; i < length; i++) {
+        unsigned int codepoint = text[i];
+        if (codepoint >= 0xD800 && codepoint < 0xE000) {
+            if (codepoint < 0xDC00 && i + 1 < length && text[i + 1] >= 0xDC00 && text[i + 1] < 0xE000)
+                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (text[++i] - 0xDC00);
+            else
+                codepoint = 0xFFFD;
+        }
+        if (codepoint < 0x80) {
+            out += (char)codepoint;
+        } else if (codepoint < 0x800) {
+            out += (char)(0xC0 | (codepoint >> 6));
+            out += (char)(0x80 | (codepoint & 0x3F));
+        } else if (codepoint < 0x10000) {
+            out += (char)(0xE0 | (codepoint >> 12));
+            out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codepoint & 0x3F));
+        } else {
+            out += (char)(0xF0 | (codepoint >> 18));
+            out += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+            out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codepoint & 0x3F));
+        }
+    }
+}
+
+// Android key codes forwarded to the active ImGui text field. DEL and FORWARD_DEL are left out: the EditText applies
+// them and they arrive as text edits
+static ImGuiKey androidKeyToImGuiKey(int keyCode) {
+    switch (keyCode) {
+        case 19: return ImGuiKey_UpArrow;       // KEYCODE_DPAD_UP
+        case 20: return ImGuiKey_DownArrow;     // KEYCODE_DPAD_DOWN
+        case 21: return ImGuiKey_LeftArrow;     // KEYCODE_DPAD_LEFT
+        case 22: return ImGuiKey_RightArrow;    // KEYCODE_DPAD_RIGHT
+        case 61: return ImGuiKey_Tab;           // KEYCODE_TAB
+        case 66: return ImGuiKey_Enter;         // KEYCODE_ENTER
+        case 92: return ImGuiKey_PageUp;        // KEYCODE_PAGE_UP
+        case 93: return ImGuiKey_PageDown;      // KEYCODE_PAGE_DOWN
+        case 111: return ImGuiKey_Escape;       // KEYCODE_ESCAPE
+        case 122: return ImGuiKey_Home;         // KEYCODE_MOVE_HOME
+        case 123: return ImGuiKey_End;          // KEYCODE_MOVE_END
+        default: return ImGuiKey_None;
+    }
+}
+
 // Constructor
 ImGuiSoftKeyboard::ImGuiSoftKeyboard()
     : m_initialized(false)
@@ -34,9 +139,20 @@ ImGuiSoftKeyboard::ImGuiSoftKeyboard()
     , m_focusedInputLabel(nullptr)
     , m_inputFocused(false)
     , m_inputType(0)
+    , m_syncedCursorPosition(0)
+    , m_textDirty(false)
+    , m_sharedSequence(0)
+    , m_javaAppliedSequence(0)
+    , m_lastTextSequence(0)
+    , m_javaSequence(0)
+    , m_resyncText(false)
+    , m_composingStart(-1)
+    , m_composingEnd(-1)
+    , m_eventsDropped(false)
+    , m_heldKey(ImGuiKey_None)
+    , m_focusedId(0)
+    , m_textVersion(0)
 {
-    m_inputBuffer.resize(MAX_INPUT_BUFFER_SIZE);
-    m_inputBuffer[0] = '\0';
 }
 
 // Destructor
@@ -56,10 +172,6 @@ bool ImGuiSoftKeyboard::initialize() {
     
     LOGI("Initializing ImGui Soft Keyboard");
     
-    // Initialize input buffer
-    m_inputBuffer.resize(MAX_INPUT_BUFFER_SIZE);
-    m_inputBuffer[0] = '\0';
-    
     m_initialized = true;
     LOGI("ImGui Soft Keyboard initialized successfully");
     
@@ -96,9 +208,7 @@ void ImGuiSoftKeyboard::showKeyboard() {
     LOGD("Showing soft keyboard");
     
     if (s_showKeyboardMethod) {
-        JNIEnv* env = getJNIEnv();
-        if (env) {
-            env->CallStaticVoidMethod(s_bridgeClass, s_showKeyboardMethod);
+        if (ImGuiJniWorker::getInstance().post([](JNIEnv* env) { env->CallStaticVoidMethod(s_bridgeClass, s_showKeyboardMethod); })) {
             m_keyboardVisible = true;
         }
     }
@@ -111,9 +221,7 @@ void ImGuiSoftKeyboard::hideKeyboard() {
     LOGD("Hiding soft keyboard");
     
     if (s_hideKeyboardMethod) {
-        JNIEnv* env = getJNIEnv();
-        if (env) {
-            env->CallStaticVoidMethod(s_bridgeClass, s_hideKeyboardMethod);
+        if (ImGuiJniWorker::getInstance().post([](JNIEnv* env) { env->CallStaticVoidMethod(s_bridgeClass, s_hideKeyboardMethod); })) {
             m_keyboardVisible = false;
         }
     }
@@ -125,14 +233,31 @@ void ImGuiSoftKeyboard::onTextInput(const std::string& text) {
     
     LOGD("Text input received: %s", text.c_str());
     
-    // Update current text
-    m_currentText = text;
+    // Java already has this text, nothing to send back. Pending native changes win over it
+    m_syncedText = text;
+    if (!m_textDirty) {
+        m_currentText = text;
+        m_textVersion++;
+    }
+}
+
+// Handle an edit of the Android text
+void ImGuiSoftKeyboard::onTextEdit(int offset, int removed, const jchar* inserted, int insertedLength, int cursor) {
+    if (!m_initialized) return;
     
-    // Update input buffer for ImGui
-    updateInputBuffer();
+    // Offsets are relative to the Java text, which is m_syncedText
+    const size_t begin = utf8Offset(m_syncedText, 0, offset);
+    const size_t end = utf8Offset(m_syncedText, begin, removed);
+    std::string insertedUtf8;
+    appendUtf8(insertedUtf8, inserted, insertedLength);
     
-    // Sync with Java side
-    syncTextWithJava();
+    // Apply it to the native text too, unless native changes are pending: the next flush overwrites the Java edit then
+    if (!m_textDirty) {
+        m_currentText.replace(begin, end - begin, insertedUtf8);
+        m_textVersion++;
+    }
+    m_syncedText.replace(begin, end - begin, insertedUtf8);
+    m_cursorPosition = m_syncedCursorPosition = cursor;
 }
 
 // Handle key events from Android keyboard
@@ -181,14 +306,33 @@ void ImGuiSoftKeyboard::onKeyboardHide() {
     
     LOGD("Keyboard hidden");
     m_keyboardVisible = false;
+    m_composingStart = m_composingEnd = -1;
     clearFocus();
 }
 
-// Set input text
+// Handle a change of the IME composing span
+void ImGuiSoftKeyboard::onComposingChanged(int start, int end) {
+    if (!m_initialized) return;
+    
+    m_composingStart = start;
+    m_composingEnd = end;
+}
+
+// Get the composing span start
+int ImGuiSoftKeyboard::getComposingStart() const {
+    return m_composingStart;
+}
+
+// Get the composing span end
+int ImGuiSoftKeyboard::getComposingEnd() const {
+    return m_composingEnd;
+}
+
+// Set input text, sent to Java by the next update()
 void ImGuiSoftKeyboard::setInputText(const std::string& text) {
+    if (text == m_currentText) return;
     m_currentText = text;
-    updateInputBuffer();
-    syncTextWithJava();
+    m_textDirty = true;
 }
 
 // Get input text
@@ -196,10 +340,9 @@ std::string ImGuiSoftKeyboard::getInputText() const {
     return m_currentText;
 }
 
-// Set cursor position
+// Set cursor position, sent to Java by the next update()
 void ImGuiSoftKeyboard::setCursorPosition(int position) {
     m_cursorPosition = position;
-    syncCursorWithJava();
 }
 
 // Get cursor position
@@ -209,80 +352,100 @@ int ImGuiSoftKeyboard::getCursorPosition() const {
 
 // Process input for ImGui
 void ImGuiSoftKeyboard::processInput() {
-    if (!m_initialized) return;
+    if (!m_initialized || !ImGui::GetCurrentContext()) return;
     
-    // Process any pending input events
-    // This is called from the main ImGui loop
-}
-
-// Custom ImGui::InputText that uses soft keyboard
-bool ImGuiSoftKeyboard::inputText(const char* label, std::string& text, ImGuiInputTextFlags flags) {
-    if (!m_initialized) return false;
-    
-    // Check if this input field is focused
-    bool isFocused = (m_focusedInputLabel == label);
-    
-    // Use ImGui's InputText for display
-    bool changed = ImGui::InputText(label, m_inputBuffer.data(), m_inputBuffer.size(), flags);
-    
-    // Check if this input field was clicked/focused
-    if (ImGui::IsItemClicked() || ImGui::IsItemFocused()) {
-        if (!isFocused) {
-            setFocusedInput(label);
-            setInputText(text);
-            showKeyboard();
-        }
+    // A key pressed last frame is released first, it has to be seen down by one NewFrame()
+    if (m_heldKey != ImGuiKey_None) {
+        setKeyDown(m_heldKey, false);
+        m_heldKey = ImGuiKey_None;
+        return;
     }
     
-    // Update text from buffer if changed
-    if (changed) {
-        text = std::string(m_inputBuffer.data());
-        setInputText(text);
+    // Edits were lost to a full queue, the native text wins
+    if (m_eventsDropped.exchange(false, std::memory_order_acquire)) {
+        LOGE("Keyboard events dropped, resyncing the text");
+        m_resyncText = true;
+        m_textDirty = true;
+        m_syncedCursorPosition = -1;
     }
     
-    // Update buffer from current text
-    if (isFocused) {
-        strncpy(m_inputBuffer.data(), m_currentText.c_str(), m_inputBuffer.size() - 1);
-        m_inputBuffer[m_inputBuffer.size() - 1] = '\0';
+    // Events queued since the last frame, in order, applied in their queue slot. Queued characters are applied by
+    // ImGui before keys, so a key press after them in the same frame keeps the order
+    while (const KeyboardEvent* event = m_eventQueue.front()) {
+        const bool keyPressed = applyEvent(*event);
+        m_eventQueue.pop();
+        if (keyPressed) return;
     }
-    
-    return changed;
+}
+
+// Custom ImGui::InputText that uses soft keyboard
+bool ImGuiSoftKeyboard::inputText(const char* label, std::string& text, ImGuiInputTextFlags flags) {
+    return inputTextField(label, text, ImVec2(0, 0), flags, false);
 }
 
 // Custom ImGui::InputTextMultiline that uses soft keyboard
 bool ImGuiSoftKeyboard::inputTextMultiline(const char* label, std::string& text, const ImVec2& size, ImGuiInputTextFlags flags) {
+    return inputTextField(label, text, size, flags, true);
+}
+
+// Shared by inputText() and inputTextMultiline()
+bool ImGuiSoftKeyboard::inputTextField(const char* label, std::string& text, const ImVec2& size, ImGuiInputTextFlags flags, bool multiline) {
     if (!m_initialized) return false;
     
-    // Check if this input field is focused
-    bool isFocused = (m_focusedInputLabel == label);
+    const ImGuiID id = ImGui::GetID(label);
+    auto inserted = m_fields.insert({ id, FieldState{ m_textVersion, -1, 0 } });
+    FieldState& field = inserted.first->second;
+    field.lastFrame = ImGui::GetFrameCount();
     
-    // Use ImGui's InputTextMultiline for display
-    bool changed = ImGui::InputTextMultiline(label, m_inputBuffer.data(), m_inputBuffer.size(), size, flags);
+    // Java edits the focused field received while ImGui was not editing it
+    const bool isFocused = (m_focusedId == id);
+    if (isFocused && field.textVersion != m_textVersion) {
+        text = m_currentText;
+        field.textVersion = m_textVersion;
+    }
+    
+    // ImGui edits the string in place, resizeCallback() grows it
+    IM_ASSERT((flags & ImGuiInputTextFlags_CallbackResize) == 0 && "The string is resized by ImGuiSoftKeyboard");
+    flags |= ImGuiInputTextFlags_CallbackResize;
+    bool changed = multiline
+        ? ImGui::InputTextMultiline(label, (char*)text.c_str(), text.capacity() + 1, size, flags, resizeCallback, &text)
+        : ImGui::InputText(label, (char*)text.c_str(), text.capacity() + 1, flags, resizeCallback, &text);
     
     // Check if this input field was clicked/focused
     if (ImGui::IsItemClicked() || ImGui::IsItemFocused()) {
         if (!isFocused) {
+            // The field that loses the focus keeps its cursor for when it gets it back
+            auto previous = m_fields.find(m_focusedId);
+            if (previous != m_fields.end()) {
+                previous->second.cursorPosition = m_cursorPosition;
+            }
             setFocusedInput(label);
             setInputText(text);
+            setCursorPosition(field.cursorPosition >= 0 ? field.cursorPosition : utf16Length(text.data(), text.size()));
+            field.textVersion = m_textVersion;
             showKeyboard();
         }
     }
     
-    // Update text from buffer if changed
-    if (changed) {
-        text = std::string(m_inputBuffer.data());
+    // Only the focused field is synced with Java
+    if (changed && m_focusedId == id) {
         setInputText(text);
     }
     
-    // Update buffer from current text
-    if (isFocused) {
-        strncpy(m_inputBuffer.data(), m_currentText.c_str(), m_inputBuffer.size() - 1);
-        m_inputBuffer[m_inputBuffer.size() - 1] = '\0';
-    }
-    
     return changed;
 }
 
+// ImGuiInputTextFlags_CallbackResize handler, the user data is the edited std::string
+int ImGuiSoftKeyboard::resizeCallback(ImGuiInputTextCallbackData* data) {
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+        std::string* text = (std::string*)data->UserData;
+        IM_ASSERT(data->Buf == text->c_str());
+        text->resize(data->BufTextLen);
+        data->Buf = (char*)text->c_str();
+    }
+    return 0;
+}
+
 // Check if any input field is currently focused
 bool ImGuiSoftKeyboard::isInputFocused() const {
     return m_inputFocused;
@@ -291,6 +454,7 @@ bool ImGuiSoftKeyboard::isInputFocused() const {
 // Set the currently focused input field
 void ImGuiSoftKeyboard::setFocusedInput(const char* label) {
     m_focusedInputLabel = label;
+    m_focusedId = label ? ImGui::GetID(label) : 0;
     m_inputFocused = true;
     
     LOGD("Input field focused: %s", label ? label : "null");
@@ -299,6 +463,7 @@ void ImGuiSoftKeyboard::setFocusedInput(const char* label) {
 // Clear focus from all input fields
 void ImGuiSoftKeyboard::clearFocus() {
     m_focusedInputLabel = nullptr;
+    m_focusedId = 0;
     m_inputFocused = false;
     
     LOGD("Input focus cleared");
@@ -325,111 +490,347 @@ void ImGuiSoftKeyboard::setHint(const std::string& hint) {
 void ImGuiSoftKeyboard::update() {
     if (!m_initialized) return;
     
-    // Sync with Java side if needed
-    if (m_inputFocused) {
-        syncTextWithJava();
-        syncCursorWithJava();
+    // Text typed into an active field comes back through inputText() and is already known to Java
+    if (m_textDirty && !m_resyncText && m_currentText == m_syncedText) {
+        m_textDirty = false;
+    }
+    
+    if (m_textDirty || m_cursorPosition != m_syncedCursorPosition) {
+        flushChangesToJava();
+    }
+    
+    // Drop the state of fields that are no longer drawn
+    const int frame = ImGui::GetCurrentContext() ? ImGui::GetFrameCount() : 0;
+    if (frame % FIELD_EXPIRE_FRAMES == 0) {
+        for (auto it = m_fields.begin(); it != m_fields.end();) {
+            if (it->first != m_focusedId && frame - it->second.lastFrame > FIELD_EXPIRE_FRAMES)
+                it = m_fields.erase(it);
+            else
+                ++it;
+        }
     }
 }
 
-// Update input buffer
-void ImGuiSoftKeyboard::updateInputBuffer() {
-    strncpy(m_inputBuffer.data(), m_currentText.c_str(), m_inputBuffer.size() - 1);
-    m_inputBuffer[m_inputBuffer.size() - 1] = '\0';
+// Queue an event for processInput(), from any thread: fill(KeyboardEvent&) sets every field of the queue slot
+template<typename Fill>
+void ImGuiSoftKeyboard::queueEvent(Fill&& fill) {
+    if (!m_eventQueue.push(fill)) {
+        m_eventsDropped.store(true, std::memory_order_release);
+    }
 }
 
-// Sync text with Java side
-void ImGuiSoftKeyboard::syncTextWithJava() {
-    if (s_setTextMethod) {
-        JNIEnv* env = getJNIEnv();
-        if (env) {
-            jstring jtext = env->NewStringUTF(m_currentText.c_str());
-            env->CallStaticVoidMethod(s_bridgeClass, s_setTextMethod, jtext);
-            env->DeleteLocalRef(jtext);
+// Set the fields of a reused queue slot, the payload is cleared but keeps its capacity
+void ImGuiSoftKeyboard::resetEvent(KeyboardEvent& event, KeyboardEvent::Type type, int offset, int removed, int cursor) {
+    event.type = type;
+    event.offset = offset;
+    event.removed = removed;
+    event.cursor = cursor;
+    event.text.clear();
+    event.chars.clear();
+    event.sequence = 0;
+    event.base = -1;
+}
+
+// Apply one queued event, returns true when it pressed a key: the following events wait for its release
+bool ImGuiSoftKeyboard::applyEvent(const KeyboardEvent& event) {
+    switch (event.type) {
+        case KeyboardEvent::TextInput:
+            onTextInput(event.text);
+            break;
+        case KeyboardEvent::TextEdit:
+            if (event.sequence > 0) {
+                m_javaSequence = event.sequence;
+            }
+            // Made on a Java text that did not have our last edit yet, the native text wins
+            if (event.base >= 0 && event.base < m_lastTextSequence) {
+                LOGD("Dropping Java edit %d made on %d, resyncing the text", event.sequence, event.base);
+                m_resyncText = true;
+                m_textDirty = true;
+                m_syncedCursorPosition = -1;
+                break;
+            }
+            // While an ImGui text field is active it edits its own copy of the text, it has to be typed into. Java's
+            // text belongs to the focused field: when another widget is active the edit is stale, the native text wins
+            if (ImGui::GetIO().WantTextInput) {
+                if (m_focusedId != 0 && ImGui::GetActiveID() == m_focusedId) {
+                    return typeTextEdit(event);
+                }
+                LOGD("Dropping Java edit %d, the focused field is not active, resyncing the text", event.sequence);
+                m_resyncText = true;
+                m_textDirty = true;
+                m_syncedCursorPosition = -1;
+                break;
+            }
+            onTextEdit(event.offset, event.removed, event.chars.data(), (int)event.chars.size(), event.cursor);
+            break;
+        case KeyboardEvent::Composing:
+            onComposingChanged(event.offset, event.removed);
+            break;
+        case KeyboardEvent::KeyDown: {
+            onKeyDown(event.offset);
+            const ImGuiKey key = androidKeyToImGuiKey(event.offset);
+            if (key != ImGuiKey_None && ImGui::GetIO().WantTextInput) {
+                m_heldKey = key;
+                setKeyDown(key, true);
+                return true;
+            }
+            break;
         }
+        case KeyboardEvent::KeyUp:
+            // Forwarded keys are released by the next processInput()
+            onKeyUp(event.offset);
+            break;
+        case KeyboardEvent::Show:
+            onKeyboardShow();
+            break;
+        case KeyboardEvent::Hide:
+            onKeyboardHide();
+            break;
     }
+    return false;
 }
 
-// Sync cursor with Java side
-void ImGuiSoftKeyboard::syncCursorWithJava() {
-    if (s_setCursorPositionMethod) {
-        JNIEnv* env = getJNIEnv();
-        if (env) {
-            env->CallStaticVoidMethod(s_bridgeClass, s_setCursorPositionMethod, m_cursorPosition);
+// Type a Java edit into the active ImGui field: the removed characters before ImGui's cursor are selected in its
+// edit state, then replaced by the inserted text (or deleted by one Backspace press), so any edit takes at most one
+// frame. IMEs replace the whole composing word on each key, the part it shares with the removed text is kept. If
+// ImGui's cursor differs from Java's the text sent back by update() brings Java in line
+bool ImGuiSoftKeyboard::typeTextEdit(const KeyboardEvent& event) {
+    if (!m_initialized) return false;
+    
+    const size_t begin = utf8Offset(m_syncedText, 0, event.offset);
+    const size_t end = utf8Offset(m_syncedText, begin, event.removed);
+    std::string inserted;
+    appendUtf8(inserted, event.chars.data(), (int)event.chars.size());
+    
+    // Common start of the removed and inserted text, cut on a character boundary
+    size_t common = 0;
+    while (begin + common < end && common < inserted.size() && m_syncedText[begin + common] == inserted[common])
+        common++;
+    while (common > 0 && ((common < inserted.size() && (inserted[common] & 0xC0) == 0x80) ||
+                          (begin + common < end && (m_syncedText[begin + common] & 0xC0) == 0x80)))
+        common--;
+    int backspaces = 0;
+    for (size_t i = begin + common; i < end; i++) {
+        if ((m_syncedText[i] & 0xC0) != 0x80)
+            backspaces++;
+    }
+    
+    // Java already has the result
+    m_syncedText.replace(begin, end - begin, inserted);
+    m_cursorPosition = m_syncedCursorPosition = event.cursor;
+    
+    // Edit state positions count characters, like 'backspaces'
+    ImGuiInputTextState* state = ImGui::GetInputTextState(ImGui::GetActiveID());
+    if (state && backspaces > 0) {
+        const int cursor = state->GetCursorPos();
+        state->Stb.select_start = ImMax(cursor - backspaces, 0);
+        state->Stb.select_end = cursor;
+    }
+    if (common < inserted.size()) {
+        ImGui::GetIO().AddInputCharactersUTF8(inserted.c_str() + common);
+        return false;
+    }
+    if (!state || backspaces == 0) return false;
+    m_heldKey = ImGuiKey_Backspace;
+    setKeyDown(m_heldKey, true);
+    return true;
+}
+
+// Press or release a key. The Android backend fills the legacy io.KeyMap / io.KeysDown[] arrays, which
+// io.AddKeyEvent() must not be mixed with: the key goes through io.KeysDown[] when it is mapped there
+void ImGuiSoftKeyboard::setKeyDown(ImGuiKey key, bool down) {
+    ImGuiIO& io = ImGui::GetIO();
+#ifndef IMGUI_DISABLE_OBSOLETE_KEYIO
+    if (io.KeyMap[key] >= 0 && io.KeyMap[key] < IM_ARRAYSIZE(io.KeysDown)) {
+        io.KeysDown[io.KeyMap[key]] = down;
+        return;
+    }
+#endif
+    io.AddKeyEvent(key, down);
+}
+
+// Send the text change since the last sync as a single edit (common prefix and suffix are left out) and the cursor
+// through s_toJava, then signal it with applySharedEditStatic(int sequence) from the JNI worker. An offset of -1 or a
+// cursor of -1 means unchanged, a removed count of -1 replaces the whole text. Nothing is sent while Java still applies
+// the previous edit, the change stays pending
+void ImGuiSoftKeyboard::flushChangesToJava() {
+    if (!s_applySharedEditMethod) return;
+    if (m_javaAppliedSequence.load(std::memory_order_acquire) != m_sharedSequence) {
+        const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_sharedSentTime);
+        if (waited.count() < SHARED_ACK_TIMEOUT_MS) return;
+        LOGE("Shared text edit %d not applied by Java, resyncing the text", m_sharedSequence);
+        m_javaAppliedSequence.store(m_sharedSequence, std::memory_order_relaxed);
+        m_resyncText = true;
+        m_textDirty = true;
+        m_syncedCursorPosition = -1;
+    }
+    
+    ImGuiJniWorker& worker = ImGuiJniWorker::getInstance();
+    if (!worker.isRunning()) return;
+    
+    // The sequence is cleared while the channel is rewritten: Java copies the edit on the worker and checks the
+    // sequence again, a copy racing with a rewrite after the ack timeout is then given up
+    jint* header = s_toJava.header;
+    __atomic_store_n(&header[SHARED_SEQUENCE], 0, __ATOMIC_RELAXED);
+    std::atomic_thread_fence(std::memory_order_release);
+    header[SHARED_OFFSET] = -1;
+    header[SHARED_REMOVED] = 0;
+    header[SHARED_LENGTH] = 0;
+    header[SHARED_BASE] = m_javaSequence;
+    if (m_resyncText) {
+        m_syncedText.clear();
+    }
+    if (m_textDirty) {
+        const std::string& from = m_syncedText;
+        const std::string& to = m_currentText;
+        auto isContinuation = [](const std::string& text, size_t i) { return i < text.size() && (text[i] & 0xC0) == 0x80; };
+        
+        // Common prefix and suffix, cut on character boundaries
+        const size_t maxCommon = std::min(from.size(), to.size());
+        size_t prefix = 0;
+        while (prefix < maxCommon && from[prefix] == to[prefix])
+            prefix++;
+        while (prefix > 0 && (isContinuation(from, prefix) || isContinuation(to, prefix)))
+            prefix--;
+        size_t suffix = 0;
+        while (suffix < maxCommon - prefix && from[from.size() - 1 - suffix] == to[to.size() - 1 - suffix])
+            suffix++;
+        while (suffix > 0 && isContinuation(to, to.size() - suffix))
+            suffix--;
+        
+        // Inserted text beyond the channel capacity is left for the next edits
+        const size_t removedSize = from.size() - prefix - suffix;
+        size_t insertedSize = to.size() - prefix - suffix;
+        header[SHARED_LENGTH] = copyUtf16(s_toJava.text, SHARED_TEXT_CAPACITY, to.data() + prefix, insertedSize);
+        header[SHARED_OFFSET] = utf16Length(from.data(), prefix);
+        header[SHARED_REMOVED] = utf16Length(from.data() + prefix, removedSize);
+        m_syncedText.replace(prefix, removedSize, to, prefix, insertedSize);
+        m_textDirty = (m_syncedText != m_currentText);
+        if (m_resyncText) {
+            header[SHARED_REMOVED] = -1;
+            m_resyncText = false;
         }
     }
+    
+    // The cursor goes with the last part of the text
+    const bool cursorChanged = !m_textDirty && m_cursorPosition != m_syncedCursorPosition;
+    header[SHARED_CURSOR] = cursorChanged ? m_cursorPosition : -1;
+    if (cursorChanged) {
+        m_syncedCursorPosition = m_cursorPosition;
+    }
+    __atomic_store_n(&header[SHARED_SEQUENCE], ++m_sharedSequence, __ATOMIC_RELEASE);
+    if (header[SHARED_OFFSET] >= 0) {
+        m_lastTextSequence = m_sharedSequence;
+    }
+    
+    // Java reads the channel from the worker thread, posting the signal publishes it
+    const jint sequence = m_sharedSequence;
+    m_sharedSentTime = std::chrono::steady_clock::now();
+    worker.post([sequence](JNIEnv* env) { env->CallStaticVoidMethod(s_bridgeClass, s_applySharedEditMethod, sequence); });
 }
 
 // Sync input type with Java side
 void ImGuiSoftKeyboard::syncInputTypeWithJava() {
     if (s_setInputTypeMethod) {
-        JNIEnv* env = getJNIEnv();
-        if (env) {
-            env->CallStaticVoidMethod(s_bridgeClass, s_setInputTypeMethod, m_inputType);
-        }
+        const int inputType = m_inputType;
+        ImGuiJniWorker::getInstance().post([inputType](JNIEnv* env) {
+            env->CallStaticVoidMethod(s_bridgeClass, s_setInputTypeMethod, inputType);
+        });
     }
 }
 
 // Sync hint with Java side
 void ImGuiSoftKeyboard::syncHintWithJava() {
     if (s_setHintMethod) {
-        JNIEnv* env = getJNIEnv();
-        if (env) {
-            jstring jhint = env->NewStringUTF(m_hintText.c_str());
+        const std::string hint = m_hintText;
+        ImGuiJniWorker::getInstance().post([hint](JNIEnv* env) {
+            jstring jhint = env->NewStringUTF(hint.c_str());
             env->CallStaticVoidMethod(s_bridgeClass, s_setHintMethod, jhint);
             env->DeleteLocalRef(jhint);
-        }
+        });
     }
 }
 
-// Get JNI environment
-JNIEnv* ImGuiSoftKeyboard::getJNIEnv() {
-    if (!s_jvm) return nullptr;
-    
-    JNIEnv* env = nullptr;
-    jint result = s_jvm->GetEnv((void**)&env, JNI_VERSION_1_6);
-    
-    if (result == JNI_EDETACHED) {
-        result = s_jvm->AttachCurrentThread(&env, nullptr);
-        if (result != JNI_OK) {
-            LOGE("Failed to attach current thread to JVM");
-            return nullptr;
-        }
+// JNI method implementations, called on the Android UI thread: events are queued for processInput()
+// The strings are copied straight into the queue slot
+void ImGuiSoftKeyboard::jniOnTextInput(JNIEnv* env, jclass clazz, jstring text) {
+    if (!g_softKeyboard) return;
+    g_softKeyboard->queueEvent([env, text](KeyboardEvent& event) {
+        resetEvent(event, KeyboardEvent::TextInput);
+        event.text.resize(env->GetStringUTFLength(text));
+        env->GetStringUTFRegion(text, 0, env->GetStringLength(text), &event.text[0]);
+    });
+}
+
+void ImGuiSoftKeyboard::jniOnTextEdit(JNIEnv* env, jclass clazz, jint offset, jint removed, jstring inserted, jint cursor) {
+    if (!g_softKeyboard) return;
+    g_softKeyboard->queueEvent([=](KeyboardEvent& event) {
+        resetEvent(event, KeyboardEvent::TextEdit, offset, removed, cursor);
+        event.chars.resize(env->GetStringLength(inserted));
+        env->GetStringRegion(inserted, 0, (jsize)event.chars.size(), event.chars.data());
+    });
+}
+
+// The text is copied out of s_toNative before returning, Java writes the next edit after this call
+void ImGuiSoftKeyboard::jniOnSharedTextEdit(JNIEnv* env, jclass clazz, jint sequence) {
+    if (!g_softKeyboard) return;
+    const jint* header = s_toNative.header;
+    if (header[SHARED_SEQUENCE] != sequence) {
+        LOGE("Shared text edit %d signaled, channel holds %d", sequence, header[SHARED_SEQUENCE]);
+        return;
     }
-    
-    return env;
+    const int length = (header[SHARED_LENGTH] < 0) ? 0 : (header[SHARED_LENGTH] > SHARED_TEXT_CAPACITY) ? SHARED_TEXT_CAPACITY : header[SHARED_LENGTH];
+    g_softKeyboard->queueEvent([header, sequence, length](KeyboardEvent& event) {
+        resetEvent(event, KeyboardEvent::TextEdit, header[SHARED_OFFSET], header[SHARED_REMOVED], header[SHARED_CURSOR]);
+        event.sequence = sequence;
+        event.base = header[SHARED_BASE];
+        event.chars.assign(s_toNative.text, s_toNative.text + length);
+    });
 }
 
-// JNI method implementations
-void ImGuiSoftKeyboard::jniOnTextInput(JNIEnv* env, jclass clazz, jstring text) {
-    const char* ctext = env->GetStringUTFChars(text, nullptr);
+void ImGuiSoftKeyboard::jniOnSharedEditApplied(JNIEnv* env, jclass clazz, jint sequence) {
+    if (g_softKeyboard) {
+        g_softKeyboard->m_javaAppliedSequence.store(sequence, std::memory_order_release);
+    }
+}
+
+void ImGuiSoftKeyboard::jniOnComposingChanged(JNIEnv* env, jclass clazz, jint start, jint end) {
     if (g_softKeyboard) {
-        g_softKeyboard->onTextInput(std::string(ctext));
+        g_softKeyboard->queueEvent([start, end](KeyboardEvent& event) {
+            resetEvent(event, KeyboardEvent::Composing, start, end);
+        });
     }
-    env->ReleaseStringUTFChars(text, ctext);
 }
 
 void ImGuiSoftKeyboard::jniOnKeyDown(JNIEnv* env, jclass clazz, jint keyCode) {
     if (g_softKeyboard) {
-        g_softKeyboard->onKeyDown(keyCode);
+        g_softKeyboard->queueEvent([keyCode](KeyboardEvent& event) {
+            resetEvent(event, KeyboardEvent::KeyDown, keyCode);
+        });
     }
 }
 
 void ImGuiSoftKeyboard::jniOnKeyUp(JNIEnv* env, jclass clazz, jint keyCode) {
     if (g_softKeyboard) {
-        g_softKeyboard->onKeyUp(keyCode);
+        g_softKeyboard->queueEvent([keyCode](KeyboardEvent& event) {
+            resetEvent(event, KeyboardEvent::KeyUp, keyCode);
+        });
     }
 }
 
 void ImGuiSoftKeyboard::jniOnKeyboardShow(JNIEnv* env, jclass clazz) {
     if (g_softKeyboard) {
-        g_softKeyboard->onKeyboardShow();
+        g_softKeyboard->queueEvent([](KeyboardEvent& event) {
+            resetEvent(event, KeyboardEvent::Show);
+        });
     }
 }
 
 void ImGuiSoftKeyboard::jniOnKeyboardHide(JNIEnv* env, jclass clazz) {
     if (g_softKeyboard) {
-        g_softKeyboard->onKeyboardHide();
+        g_softKeyboard->queueEvent([](KeyboardEvent& event) {
+            resetEvent(event, KeyboardEvent::Hide);
+        });
     }
 }
 
@@ -461,15 +862,32 @@ bool ImGuiSoftKeyboard::registerJNIMethods(JNIEnv* env) {
     s_getCursorPositionMethod = env->GetStaticMethodID(s_bridgeClass, "getCursorPositionStatic", "()I");
     s_setInputTypeMethod = env->GetStaticMethodID(s_bridgeClass, "setInputType", "(I)V");
     s_setHintMethod = env->GetStaticMethodID(s_bridgeClass, "setHint", "(Ljava/lang/String;)V");
+    s_applySharedEditMethod = env->GetStaticMethodID(s_bridgeClass, "applySharedEditStatic", "(I)V");
+    s_setSharedBuffersMethod = env->GetStaticMethodID(s_bridgeClass, "setSharedBuffersStatic", "(Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V");
     
     // Check if all methods were found
     if (!s_showKeyboardMethod || !s_hideKeyboardMethod || !s_isKeyboardVisibleMethod ||
         !s_setTextMethod || !s_getTextMethod || !s_setCursorPositionMethod ||
-        !s_getCursorPositionMethod || !s_setInputTypeMethod || !s_setHintMethod) {
+        !s_getCursorPositionMethod || !s_setInputTypeMethod || !s_setHintMethod || !s_applySharedEditMethod ||
+        !s_setSharedBuffersMethod) {
         LOGE("Failed to find some JNI methods");
         return false;
     }
     
+    // Shared text channels, Java keeps the buffers
+    jobject toNativeBuffer = env->NewDirectByteBuffer(&s_toNative, sizeof(s_toNative));
+    jobject toJavaBuffer = env->NewDirectByteBuffer(&s_toJava, sizeof(s_toJava));
+    if (!toNativeBuffer || !toJavaBuffer) {
+        LOGE("Failed to create the shared text buffers");
+        return false;
+    }
+    env->CallStaticVoidMethod(s_bridgeClass, s_setSharedBuffersMethod, toNativeBuffer, toJavaBuffer);
+    env->DeleteLocalRef(toNativeBuffer);
+    env->DeleteLocalRef(toJavaBuffer);
+    
+    // Java calls made by the render thread go through the worker
+    ImGuiJniWorker::getInstance().start(s_jvm);
+    
     LOGI("JNI methods registered successfully");
     return true;
 }
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "../ImGui/imgui.h"
+#include "ImGuiMpscQueue.h"
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <jni.h>
 
@@ -30,6 +34,9 @@ public:
     // Handle text input from Android keyboard
     void onTextInput(const std::string& text);
     
+    // Handle an edit of the Android text: 'removed' UTF-16 units at 'offset' replaced by 'inserted', then cursor moved
+    void onTextEdit(int offset, int removed, const jchar* inserted, int insertedLength, int cursor);
+    
     // Handle key events from Android keyboard
     void onKeyDown(int keyCode);
     void onKeyUp(int keyCode);
@@ -38,16 +45,24 @@ public:
     void onKeyboardShow();
     void onKeyboardHide();
     
+    // Handle a change of the IME composing span, UTF-16 offsets in the Android text (-1 when there is none)
+    void onComposingChanged(int start, int end);
+    int getComposingStart() const;
+    int getComposingEnd() const;
+    
     // Set input text and cursor position
     void setInputText(const std::string& text);
     std::string getInputText() const;
     void setCursorPosition(int position);
     int getCursorPosition() const;
     
-    // Process input for ImGui (call this in your main loop)
+    // Apply the keyboard events queued by the JNI callbacks, call it once per frame on the render thread before
+    // ImGui::NewFrame(). Text typed while an ImGui text field is active replaces a selection in the field's edit
+    // state through io.AddInputCharactersUTF8() (or a single Backspace press), keys go through ImGui's key input
     void processInput();
     
-    // Custom ImGui::InputText that uses soft keyboard
+    // Custom ImGui::InputText that uses soft keyboard. The string is edited in place and grows as needed,
+    // only the focused field exchanges its text with Java
     bool inputText(const char* label, std::string& text, ImGuiInputTextFlags flags = 0);
     
     // Custom ImGui::InputTextMultiline that uses soft keyboard
@@ -56,7 +71,7 @@ public:
     // Check if any input field is currently focused
     bool isInputFocused() const;
     
-    // Set the currently focused input field
+    // Set the currently focused input field, identified by its label in the current ImGui ID stack
     void setFocusedInput(const char* label);
     
     // Clear focus from all input fields
@@ -71,18 +86,29 @@ public:
     // Set hint text for keyboard
     void setHint(const std::string& hint);
     
-    // Update method to be called each frame
+    // Update method to be called each frame, sends the text and cursor changes to Java in one call (none when unchanged)
     void update();
     
     // JNI methods for Java communication
     static void jniOnTextInput(JNIEnv* env, jclass clazz, jstring text);
+    static void jniOnTextEdit(JNIEnv* env, jclass clazz, jint offset, jint removed, jstring inserted, jint cursor);
+    static void jniOnSharedTextEdit(JNIEnv* env, jclass clazz, jint sequence);
+    static void jniOnSharedEditApplied(JNIEnv* env, jclass clazz, jint sequence);
     static void jniOnKeyDown(JNIEnv* env, jclass clazz, jint keyCode);
     static void jniOnKeyUp(JNIEnv* env, jclass clazz, jint keyCode);
     static void jniOnKeyboardShow(JNIEnv* env, jclass clazz);
     static void jniOnKeyboardHide(JNIEnv* env, jclass clazz);
+    static void jniOnComposingChanged(JNIEnv* env, jclass clazz, jint start, jint end);
     
-    // Register JNI methods
+    // Register JNI methods and hand the shared text channels to Java
     static bool registerJNIMethods(JNIEnv* env);
+    
+    // Shared text channel layout, mirrored in ImGuiKeyboardBridge.java: SHARED_HEADER_INTS ints then up to
+    // SHARED_TEXT_CAPACITY UTF-16 units. Longer edits are split. SHARED_BASE is the last sequence of the other
+    // direction the writer had applied when it made the edit, its offsets are only valid on top of that text
+    static const int SHARED_HEADER_INTS = 8;
+    static const int SHARED_TEXT_CAPACITY = 16384;
+    enum SharedHeader { SHARED_SEQUENCE, SHARED_OFFSET, SHARED_REMOVED, SHARED_LENGTH, SHARED_CURSOR, SHARED_BASE };
 
 private:
     ImGuiSoftKeyboard();
@@ -102,9 +128,63 @@ private:
     int m_inputType;
     std::string m_hintText;
     
-    // Text input buffer for ImGui
-    std::vector<char> m_inputBuffer;
-    static const size_t MAX_INPUT_BUFFER_SIZE = 1024;
+    // Text and cursor as last sent to or received from Java. Changes to m_currentText are diffed against it and sent
+    // as (offset, removed, inserted) edits in UTF-16 units
+    std::string m_syncedText;
+    int m_syncedCursorPosition;
+    bool m_textDirty;
+    
+    // Last edit written to s_toJava and last one Java is done with: the channel is not written again until they match.
+    // Java acknowledges from a UI thread runnable, which is lost if the activity goes away: after SHARED_ACK_TIMEOUT_MS
+    // the edit is given up and the whole text is sent again
+    int m_sharedSequence;
+    std::atomic<int> m_javaAppliedSequence;
+    std::chrono::steady_clock::time_point m_sharedSentTime;
+    static const int SHARED_ACK_TIMEOUT_MS = 1000;
+    
+    // Java edits made before Java applied m_lastTextSequence, the last edit that changed its text, have offsets into
+    // an older text: they are dropped and the whole text is sent again (m_resyncText). m_javaSequence is the last
+    // Java edit received, Java drops native edits made before it the same way
+    int m_lastTextSequence;
+    int m_javaSequence;
+    bool m_resyncText;
+    int m_composingStart;
+    int m_composingEnd;
+    
+    // Event sent by the JNI callbacks, which run on the Android UI thread. They only queue it, all state is owned
+    // by the render thread. Events are built in place in the queue's slots, whose strings keep their capacity
+    struct KeyboardEvent {
+        enum Type { TextInput, TextEdit, Composing, KeyDown, KeyUp, Show, Hide };
+        Type type;
+        int offset;                 // TextEdit: UTF-16 offset, Composing: span start, KeyDown/KeyUp: key code
+        int removed;                // TextEdit: removed UTF-16 units, Composing: span end
+        int cursor;                 // TextEdit: cursor after the edit
+        std::string text;           // TextInput: whole text
+        std::vector<jchar> chars;   // TextEdit: inserted text
+        int sequence;               // TextEdit: Java sequence number, 0 when sent without one
+        int base;                   // TextEdit: native sequence the edit was made on, -1 when unknown
+    };
+    static const size_t EVENT_QUEUE_CAPACITY = 256;
+    ImGuiMpscQueue<KeyboardEvent, EVENT_QUEUE_CAPACITY> m_eventQueue;
+    
+    // Set by a JNI callback that found the queue full, the next processInput() resyncs the whole text
+    std::atomic<bool> m_eventsDropped;
+    
+    // Render thread side of processInput(). Legacy key arrays need a key to stay down for a frame, events after a
+    // key press stay in m_eventQueue until it is released
+    ImGuiKey m_heldKey;
+    
+    // Per-field state, keyed by the ImGuiID of the widget. The text lives in the caller's std::string, which ImGui
+    // edits in place and grows through ImGuiInputTextFlags_CallbackResize
+    struct FieldState {
+        int textVersion;            // Value of m_textVersion when the field's string was last updated from Java
+        int cursorPosition;         // Cursor sent to Java when the field gets the focus back, -1 for the end
+        int lastFrame;              // Frame the field was last drawn, fields gone for FIELD_EXPIRE_FRAMES are dropped
+    };
+    std::unordered_map<ImGuiID, FieldState> m_fields;
+    ImGuiID m_focusedId;
+    int m_textVersion;              // Incremented when Java changes m_currentText
+    static const int FIELD_EXPIRE_FRAMES = 600;
     
     // JNI environment and class references
     static JavaVM* s_jvm;
@@ -118,16 +198,31 @@ private:
     static jmethodID s_getCursorPositionMethod;
     static jmethodID s_setInputTypeMethod;
     static jmethodID s_setHintMethod;
+    static jmethodID s_applySharedEditMethod;
+    static jmethodID s_setSharedBuffersMethod;
+    
+    // Edits in each direction go through a direct ByteBuffer over these, JNI calls only carry the sequence number.
+    // The Java to native channel is read on the UI thread by the JNI call that signals it
+    struct SharedTextChannel {
+        jint header[SHARED_HEADER_INTS];
+        jchar text[SHARED_TEXT_CAPACITY];
+    };
+    static SharedTextChannel s_toNative;
+    static SharedTextChannel s_toJava;
     
     // Helper methods
-    void updateInputBuffer();
-    void syncTextWithJava();
-    void syncCursorWithJava();
+    template<typename Fill> void queueEvent(Fill&& fill);
+    static void resetEvent(KeyboardEvent& event, KeyboardEvent::Type type, int offset = 0, int removed = 0, int cursor = 0);
+    bool applyEvent(const KeyboardEvent& event);
+    bool typeTextEdit(const KeyboardEvent& event);
+    void setKeyDown(ImGuiKey key, bool down);
+    bool inputTextField(const char* label, std::string& text, const ImVec2& size, ImGuiInputTextFlags flags, bool multiline);
+    static int resizeCallback(ImGuiInputTextCallbackData* data);
+    void flushChangesToJava();
     void syncInputTypeWithJava();
     void syncHintWithJava();
     
     // JNI helper methods
-    JNIEnv* getJNIEnv();
     void callJavaMethod(jmethodID methodID, ...);
     bool callJavaBooleanMethod(jmethodID methodID, ...);
     std::string callJavaStringMethod(jmethodID methodID, ...);
@@ -1,4 +1,5 @@
 #include "ImGuiSoftKeyboard.h"
+#include "ImGuiAutocomplete.h"
 #include <string>
 
 /**
@@ -248,7 +249,12 @@ void DrawAutocompleteExamples() {
     static std::vector<std::string> suggestions = {
         "Android", "ImGui", "Soft Keyboard", "JNI", "C++", "Java", "OpenGL", "NDK"
     };
-    static std::vector<std::string> filteredSuggestions;
+    static ImGuiAutocomplete autocomplete;
+    static bool indexed = false;
+    if (!indexed) {
+        autocomplete.setEntries(suggestions);
+        indexed = true;
+    }
     
     ImGui::Begin("Autocomplete Examples");
     
@@ -256,25 +262,18 @@ void DrawAutocompleteExamples() {
     ImGui::Separator();
     
     // Search input
-    if (ImGui::InputTextWithSoftKeyboard("Search", searchInput)) {
-        // Filter suggestions based on input
-        filteredSuggestions.clear();
-        if (!searchInput.empty()) {
-            for (const auto& suggestion : suggestions) {
-                if (suggestion.find(searchInput) != std::string::npos) {
-                    filteredSuggestions.push_back(suggestion);
-                }
-            }
-        }
-    }
+    ImGui::InputTextWithSoftKeyboard("Search", searchInput);
     
-    // Show suggestions
-    if (!searchInput.empty() && !filteredSuggestions.empty()) {
+    // Show suggestions, the index answers from the previous entries while it is rebuilt. Matches start at a word
+    // ("key" finds "Soft Keyboard", "board" does not)
+    const std::vector<ImGuiAutocomplete::Match>& matches = autocomplete.query(searchInput.c_str(), 10);
+    if (!matches.empty()) {
         ImGui::Text("Suggestions:");
-        for (const auto& suggestion : filteredSuggestions) {
-            if (ImGui::Selectable(suggestion.c_str())) {
+        for (const ImGuiAutocomplete::Match& match : matches) {
+            const char* suggestion = autocomplete.getEntry(match.entry);
+            if (ImGui::Selectable(suggestion) && searchInput != suggestion) {
                 searchInput = suggestion;
-                filteredSuggestions.clear();
+                break;
             }
         }
     }
@@ -289,6 +288,7 @@ void DrawAutocompleteExamples() {
     
     if (ImGui::Button("Add to Suggestions") && !newSuggestion.empty()) {
         suggestions.push_back(newSuggestion);
+        autocomplete.setEntries(suggestions);
         newSuggestion.clear();
     }
     
@@ -16,68 +16,43 @@ Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnTextInput(JNIEnv* env, jcl
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyDown(JNIEnv* env, jclass clazz, jint keyCode) {
-    ImGuiSoftKeyboard::jniOnKeyDown(env, clazz, keyCode);
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnTextEdit(JNIEnv* env, jclass clazz, jint offset, jint removed, jstring inserted, jint cursor) {
+    ImGuiSoftKeyboard::jniOnTextEdit(env, clazz, offset, removed, inserted, cursor);
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyUp(JNIEnv* env, jclass clazz, jint keyCode) {
-    ImGuiSoftKeyboard::jniOnKeyUp(env, clazz, keyCode);
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnSharedTextEdit(JNIEnv* env, jclass clazz, jint sequence) {
+    ImGuiSoftKeyboard::jniOnSharedTextEdit(env, clazz, sequence);
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyboardShow(JNIEnv* env, jclass clazz) {
-    ImGuiSoftKeyboard::jniOnKeyboardShow(env, clazz);
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnSharedEditApplied(JNIEnv* env, jclass clazz, jint sequence) {
+    ImGuiSoftKeyboard::jniOnSharedEditApplied(env, clazz, sequence);
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyboardHide(JNIEnv* env, jclass clazz) {
-    ImGuiSoftKeyboard::jniOnKeyboardHide(env, clazz);
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnComposingChanged(JNIEnv* env, jclass clazz, jint start, jint end) {
+    ImGuiSoftKeyboard::jniOnComposingChanged(env, clazz, start, end);
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeSetInputFocus(JNIEnv* env, jclass clazz, jboolean focused) {
-    if (g_softKeyboard) {
-        if (focused) {
-            // Focus is handled by ImGui input system
-            LOGD("Input focus set from Java");
-        } else {
-            g_softKeyboard->clearFocus();
-        }
-    }
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyDown(JNIEnv* env, jclass clazz, jint keyCode) {
+    ImGuiSoftKeyboard::jniOnKeyDown(env, clazz, keyCode);
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeSetInputText(JNIEnv* env, jclass clazz, jstring text) {
-    if (g_softKeyboard) {
-        const char* ctext = env->GetStringUTFChars(text, nullptr);
-        g_softKeyboard->setInputText(std::string(ctext));
-        env->ReleaseStringUTFChars(text, ctext);
-    }
-}
-
-JNIEXPORT jstring JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeGetInputText(JNIEnv* env, jclass clazz) {
-    if (g_softKeyboard) {
-        std::string text = g_softKeyboard->getInputText();
-        return env->NewStringUTF(text.c_str());
-    }
-    return env->NewStringUTF("");
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyUp(JNIEnv* env, jclass clazz, jint keyCode) {
+    ImGuiSoftKeyboard::jniOnKeyUp(env, clazz, keyCode);
 }
 
 JNIEXPORT void JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeSetCursorPosition(JNIEnv* env, jclass clazz, jint position) {
-    if (g_softKeyboard) {
-        g_softKeyboard->setCursorPosition(position);
-    }
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyboardShow(JNIEnv* env, jclass clazz) {
+    ImGuiSoftKeyboard::jniOnKeyboardShow(env, clazz);
 }
 
-JNIEXPORT jint JNICALL
-Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeGetCursorPosition(JNIEnv* env, jclass clazz) {
-    if (g_softKeyboard) {
-        return g_softKeyboard->getCursorPosition();
-    }
-    return 0;
+JNIEXPORT void JNICALL
+Java_com_reveny_imgui_mod_ImGuiKeyboardBridge_nativeOnKeyboardHide(JNIEnv* env, jclass clazz) {
+    ImGuiSoftKeyboard::jniOnKeyboardHide(env, clazz);
 }
 
 } // extern "C"
\ No newline at end of file
@@ -0,0 +1,254 @@
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "ImGuiStreamingPlot.h"
+#include "ImGui/imgui_internal.h"
+#include <algorithm>
+#include <cstring>
+
+// Constructor
+ImGuiStreamingPlot::ImGuiStreamingPlot(int capacity)
+    : m_capacity(2)
+    , m_total(0)
+{
+    while (m_capacity < capacity)
+        m_capacity *= 2;
+    m_samples.resize(m_capacity, 0.0f);
+    m_nodes.resize(m_capacity);
+    clear();
+}
+
+// Add one sample, overwriting the oldest one when full
+void ImGuiStreamingPlot::push(float value) {
+    const int slot = (int)(m_total & (m_capacity - 1));
+    m_samples[slot] = value;
+    m_total++;
+    updateNodes(slot, slot + 1);
+}
+
+// Add samples in order. Tree nodes are refreshed once per batch
+void ImGuiStreamingPlot::push(const float* values, int count) {
+    if (count <= 0)
+        return;
+    if (count > m_capacity) {
+        values += count - m_capacity; // Only the last 'capacity' samples survive
+        m_total += count - m_capacity;
+        count = m_capacity;
+    }
+    const int slotBegin = (int)(m_total & (m_capacity - 1));
+    const int firstCount = ImMin(count, m_capacity - slotBegin);
+    memcpy(&m_samples[slotBegin], values, firstCount * sizeof(float));
+    memcpy(&m_samples[0], values + firstCount, (count - firstCount) * sizeof(float));
+    m_total += count;
+    updateNodes(slotBegin, slotBegin + firstCount);
+    if (count > firstCount)
+        updateNodes(0, count - firstCount);
+}
+
+void ImGuiStreamingPlot::clear() {
+    m_total = 0;
+    const Range empty = { FLT_MAX, -FLT_MAX };
+    std::fill(m_nodes.begin(), m_nodes.end(), empty);
+}
+
+int ImGuiStreamingPlot::getCount() const {
+    return (int)ImMin(m_total, (long long)m_capacity);
+}
+
+int ImGuiStreamingPlot::getCapacity() const {
+    return m_capacity;
+}
+
+float ImGuiStreamingPlot::getLast() const {
+    return m_total > 0 ? getSample(m_total - 1) : 0.0f;
+}
+
+bool ImGuiStreamingPlot::getRange(int first, int count, float* outMin, float* outMax) const {
+    first = ImClamp(first, 0, getCount());
+    count = ImClamp(count, 0, getCount() - first);
+    const long long begin = m_total - getCount() + first;
+    const Range range = (count > 0) ? query(begin, begin + count) : Range{ FLT_MAX, -FLT_MAX };
+    if (range.min > range.max)
+        return false;
+    *outMin = range.min;
+    *outMax = range.max;
+    return true;
+}
+
+void ImGuiStreamingPlot::plotLines(const char* label, const char* overlayText, float scaleMin, float scaleMax, ImVec2 graphSize, int viewCount) {
+    plot(false, label, overlayText, scaleMin, scaleMax, graphSize, viewCount);
+}
+
+void ImGuiStreamingPlot::plotHistogram(const char* label, const char* overlayText, float scaleMin, float scaleMax, ImVec2 graphSize, int viewCount) {
+    plot(true, label, overlayText, scaleMin, scaleMax, graphSize, viewCount);
+}
+
+// Walk up one level at a time, each parent of the range being refreshed once. Stops as soon as a level is unchanged
+void ImGuiStreamingPlot::updateNodes(int slotBegin, int slotEnd) {
+    int first = (m_capacity + slotBegin) >> 1;
+    int last = (m_capacity + slotEnd - 1) >> 1;
+    for (bool changed = true; changed && first >= 1; first >>= 1, last >>= 1) {
+        changed = false;
+        for (int node = first; node <= last; node++) {
+            const Range lhs = getNode(node * 2);
+            const Range rhs = getNode(node * 2 + 1);
+            const float min = ImMin(lhs.min, rhs.min);
+            const float max = ImMax(lhs.max, rhs.max);
+            if (min != m_nodes[node].min || max != m_nodes[node].max) {
+                m_nodes[node].min = min;
+                m_nodes[node].max = max;
+                changed = true;
+            }
+        }
+    }
+}
+
+ImGuiStreamingPlot::Range ImGuiStreamingPlot::getNode(int node) const {
+    if (node < m_capacity)
+        return m_nodes[node];
+    const float value = m_samples[node - m_capacity];
+    if (value != value) { // Ignore NaN values
+        const Range empty = { FLT_MAX, -FLT_MAX };
+        return empty;
+    }
+    const Range range = { value, value };
+    return range;
+}
+
+// Bottom-up segment tree query, O(log capacity)
+ImGuiStreamingPlot::Range ImGuiStreamingPlot::querySlots(int slotBegin, int slotEnd) const {
+    Range range = { FLT_MAX, -FLT_MAX };
+    for (int lo = m_capacity + slotBegin, hi = m_capacity + slotEnd; lo < hi; lo >>= 1, hi >>= 1) {
+        if (lo & 1) {
+            const Range node = getNode(lo++);
+            range.min = ImMin(range.min, node.min);
+            range.max = ImMax(range.max, node.max);
+        }
+        if (hi & 1) {
+            const Range node = getNode(--hi);
+            range.min = ImMin(range.min, node.min);
+            range.max = ImMax(range.max, node.max);
+        }
+    }
+    return range;
+}
+
+// Split the range where it wraps around the ring
+ImGuiStreamingPlot::Range ImGuiStreamingPlot::query(long long begin, long long end) const {
+    const int slotBegin = (int)(begin & (m_capacity - 1));
+    const int count = (int)(end - begin);
+    if (slotBegin + count <= m_capacity)
+        return querySlots(slotBegin, slotBegin + count);
+    Range range = querySlots(slotBegin, m_capacity);
+    const Range wrapped = querySlots(0, slotBegin + count - m_capacity);
+    range.min = ImMin(range.min, wrapped.min);
+    range.max = ImMax(range.max, wrapped.max);
+    return range;
+}
+
+float ImGuiStreamingPlot::getSample(long long index) const {
+    return m_samples[(int)(index & (m_capacity - 1))];
+}
+
+// Same layout and look as ImGui::PlotEx(). With more samples than pixels, each pixel column draws the min to max extent
+// of its samples, joined to the neighbor columns through their first and last samples
+void ImGuiStreamingPlot::plot(bool histogram, const char* label, const char* overlayText, float scaleMin, float scaleMax, ImVec2 graphSize, int viewCount) {
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    const ImGuiStyle& style = g.Style;
+    const ImGuiID id = window->GetID(label);
+
+    const ImVec2 labelSize = ImGui::CalcTextSize(label, NULL, true);
+    if (graphSize.x == 0.0f)
+        graphSize.x = ImGui::CalcItemWidth();
+    if (graphSize.y == 0.0f)
+        graphSize.y = labelSize.y + (style.FramePadding.y * 2);
+
+    const ImRect frameBb(window->DC.CursorPos, window->DC.CursorPos + graphSize);
+    const ImRect innerBb(frameBb.Min + style.FramePadding, frameBb.Max - style.FramePadding);
+    const ImRect totalBb(frameBb.Min, frameBb.Max + ImVec2(labelSize.x > 0.0f ? style.ItemInnerSpacing.x + labelSize.x : 0.0f, 0));
+    ImGui::ItemSize(totalBb, style.FramePadding.y);
+    if (!ImGui::ItemAdd(totalBb, 0, &frameBb))
+        return;
+    const bool hovered = ImGui::ItemHoverable(frameBb, id);
+
+    const int count = getCount();
+    const int viewSamples = (viewCount > 0) ? ImMin(viewCount, count) : count;
+    const long long viewBegin = m_total - viewSamples;
+
+    // Determine scale from values if not specified
+    if (scaleMin == FLT_MAX || scaleMax == FLT_MAX) {
+        const Range range = (viewSamples > 0) ? query(viewBegin, m_total) : Range{ FLT_MAX, -FLT_MAX };
+        if (scaleMin == FLT_MAX)
+            scaleMin = range.min;
+        if (scaleMax == FLT_MAX)
+            scaleMax = range.max;
+    }
+
+    ImGui::RenderFrame(frameBb.Min, frameBb.Max, ImGui::GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+    const int minSamples = histogram ? 1 : 2;
+    if (viewSamples >= minSamples) {
+        // One column per sample, or per pixel when there are more samples than pixels
+        const int columns = ImClamp((int)innerBb.GetWidth(), minSamples, viewSamples);
+        const float columnStep = 1.0f / (float)(histogram ? columns : columns - 1);
+        const float invScale = (scaleMin == scaleMax) ? 0.0f : (1.0f / (scaleMax - scaleMin));
+        const float zeroLineT = (scaleMin * scaleMax < 0.0f) ? (1 + scaleMin * invScale) : (scaleMin < 0.0f ? 0.0f : 1.0f);
+
+        // Tooltip on hover
+        int hoveredColumn = -1;
+        if (hovered && innerBb.Contains(g.IO.MousePos)) {
+            const float t = ImClamp((g.IO.MousePos.x - innerBb.Min.x) / (innerBb.Max.x - innerBb.Min.x), 0.0f, 0.9999f);
+            hoveredColumn = histogram ? (int)(t * columns) : (int)(t * (columns - 1) + 0.5f);
+            const int first = (int)((long long)hoveredColumn * viewSamples / columns);
+            const int last = (int)((long long)(hoveredColumn + 1) * viewSamples / columns) - 1;
+            const Range range = query(viewBegin + first, viewBegin + last + 1);
+            if (first == last)
+                ImGui::SetTooltip("%d: %8.4g", first, getSample(viewBegin + first));
+            else
+                ImGui::SetTooltip("%d-%d: %8.4g .. %8.4g", first, last, range.min, range.max);
+        }
+
+        const ImU32 colBase = ImGui::GetColorU32(histogram ? ImGuiCol_PlotHistogram : ImGuiCol_PlotLines);
+        const ImU32 colHovered = ImGui::GetColorU32(histogram ? ImGuiCol_PlotHistogramHovered : ImGuiCol_PlotLinesHovered);
+        auto valueToT = [&](float v) { return 1.0f - ImSaturate((v - scaleMin) * invScale); };
+
+        ImVec2 prevPos;
+        bool hasPrev = false;
+        for (int n = 0; n < columns; n++) {
+            const long long begin = viewBegin + (long long)n * viewSamples / columns;
+            const long long end = viewBegin + (long long)(n + 1) * viewSamples / columns;
+            const Range range = (end - begin == 1) ? getNode(m_capacity + (int)(begin & (m_capacity - 1))) : query(begin, end);
+            const ImU32 col = (n == hoveredColumn) ? colHovered : colBase;
+
+            if (histogram) {
+                if (range.min > range.max)
+                    continue;
+                ImVec2 pos0 = ImLerp(innerBb.Min, innerBb.Max, ImVec2(n * columnStep, ImMin(valueToT(range.max), zeroLineT)));
+                ImVec2 pos1 = ImLerp(innerBb.Min, innerBb.Max, ImVec2((n + 1) * columnStep, ImMax(valueToT(range.min), zeroLineT)));
+                if (pos1.x >= pos0.x + 2.0f)
+                    pos1.x -= 1.0f;
+                window->DrawList->AddRectFilled(pos0, pos1, col);
+                continue;
+            }
+
+            const float x = ImLerp(innerBb.Min.x, innerBb.Max.x, n * columnStep);
+            if (range.min < range.max)
+                window->DrawList->AddLine(ImVec2(x, ImLerp(innerBb.Min.y, innerBb.Max.y, valueToT(range.max))), ImVec2(x, ImLerp(innerBb.Min.y, innerBb.Max.y, valueToT(range.min))), col);
+            const float first = getSample(begin);
+            const float last = getSample(end - 1);
+            if (hasPrev && first == first)
+                window->DrawList->AddLine(prevPos, ImVec2(x, ImLerp(innerBb.Min.y, innerBb.Max.y, valueToT(first))), col);
+            hasPrev = (last == last); // Lines stop at NaN values
+            prevPos = ImVec2(x, ImLerp(innerBb.Min.y, innerBb.Max.y, valueToT(last)));
+        }
+    }
+
+    // Text overlay
+    if (overlayText)
+        ImGui::RenderTextClipped(ImVec2(frameBb.Min.x, frameBb.Min.y + style.FramePadding.y), frameBb.Max, overlayText, NULL, NULL, ImVec2(0.5f, 0.0f));
+
+    if (labelSize.x > 0.0f)
+        ImGui::RenderText(ImVec2(frameBb.Max.x + style.ItemInnerSpacing.x, innerBb.Min.y), label);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ImGui/imgui.h"
+#include <cfloat>
+#include <vector>
+
+/**
+ * Streaming plot for high-rate telemetry (frame times, memory counters...)
+ * Samples go into a fixed-capacity ring buffer, the oldest being overwritten once full. A min/max tree over the ring
+ * is kept up to date as samples arrive, so each pixel column of the plot gets the min and max of the samples it covers
+ * in O(log capacity): drawing costs O(width) whatever the number of samples, spikes are never dropped, and nothing is
+ * allocated after construction.
+ * push() and the plot functions must be called from the same thread (or synchronized by the caller).
+ * Usage:
+ *   static ImGuiStreamingPlot frameTimes(1 << 20);
+ *   frameTimes.push(ImGui::GetIO().DeltaTime * 1000.0f);
+ *   frameTimes.plotLines("Frame time (ms)", NULL, 0.0f, 50.0f, ImVec2(0, 80));
+ */
+class ImGuiStreamingPlot {
+public:
+    // Keep the last 'capacity' samples (rounded up to a power of two)
+    explicit ImGuiStreamingPlot(int capacity);
+
+    void push(float value);
+    void push(const float* values, int count);
+    void clear();
+
+    // Samples currently stored, at most getCapacity()
+    int getCount() const;
+    int getCapacity() const;
+
+    // Most recent sample, 0 when empty
+    float getLast() const;
+
+    // Min and max of 'count' stored samples starting at 'first' (0 = oldest stored sample), NaN samples ignored.
+    // O(log capacity). Returns false when the range is empty or only holds NaN
+    bool getRange(int first, int count, float* outMin, float* outMax) const;
+
+    // Same parameters as ImGui::PlotLines() / ImGui::PlotHistogram(). 'viewCount' limits the plot to the most recent samples (0 = every stored sample)
+    void plotLines(const char* label, const char* overlayText = NULL, float scaleMin = FLT_MAX, float scaleMax = FLT_MAX, ImVec2 graphSize = ImVec2(0, 0), int viewCount = 0);
+    void plotHistogram(const char* label, const char* overlayText = NULL, float scaleMin = FLT_MAX, float scaleMax = FLT_MAX, ImVec2 graphSize = ImVec2(0, 0), int viewCount = 0);
+
+private:
+    // Min and max of a range of samples, NaN samples are ignored (min > max when the range only holds NaN)
+    struct Range {
+        float min;
+        float max;
+    };
+
+    void plot(bool histogram, const char* label, const char* overlayText, float scaleMin, float scaleMax, ImVec2 graphSize, int viewCount);
+
+    // Refresh the tree nodes above the ring slots [slotBegin, slotEnd)
+    void updateNodes(int slotBegin, int slotEnd);
+
+    // Range of tree node 'node' (leaves are the samples)
+    Range getNode(int node) const;
+
+    // Range of the samples [begin, end), in absolute sample numbers
+    Range query(long long begin, long long end) const;
+    Range querySlots(int slotBegin, int slotEnd) const;
+
+    float getSample(long long index) const;
+
+    std::vector<float> m_samples;   // Ring buffer, sample n is in slot n & (capacity - 1)
+    std::vector<Range> m_nodes;     // Implicit binary tree over the slots: node 1 is the root, nodes n have children 2n and 2n + 1, leaf 'capacity + slot' is the sample
+    int m_capacity;
+    long long m_total;              // Samples pushed since construction or clear()
+};
@@ -0,0 +1,286 @@
+#include "ImGuiTableSorter.h"
+#include <algorithm>
+#include <numeric>
+
+// UI thread time spent per update() on a resort when there is no core to run it on the pool
+static const int SLICE_BUDGET_US = 2000;
+
+// Constructor
+ImGuiWorkerPool::ImGuiWorkerPool()
+    : m_quit(false)
+{
+    const int cores = (int)std::thread::hardware_concurrency();
+    const int threadCount = cores > 2 ? cores - 1 : 1;
+    for (int n = 0; n < threadCount; n++)
+        m_threads.emplace_back(&ImGuiWorkerPool::workerLoop, this);
+}
+
+// Destructor
+ImGuiWorkerPool::~ImGuiWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_condition.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+// Get singleton instance
+ImGuiWorkerPool& ImGuiWorkerPool::getInstance() {
+    static ImGuiWorkerPool instance;
+    return instance;
+}
+
+int ImGuiWorkerPool::getThreadCount() const {
+    return (int)m_threads.size();
+}
+
+// Run a task asynchronously
+void ImGuiWorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+// Pop and run one queued task, false if the queue was empty
+bool ImGuiWorkerPool::runOneTask() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty())
+            return false;
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+// Pool thread main loop
+void ImGuiWorkerPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_quit || !m_tasks.empty(); });
+            if (m_quit)
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+// Run fn(0) .. fn(count - 1) in parallel. The caller runs fn(0) and helps with queued tasks until all are done
+void ImGuiWorkerPool::parallelFor(int count, const std::function<void(int)>& fn) {
+    if (count <= 0)
+        return;
+    std::atomic<int> remaining(count);
+    for (int n = 1; n < count; n++) {
+        submit([&fn, &remaining, n] {
+            fn(n);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    fn(0);
+    remaining.fetch_sub(1, std::memory_order_release);
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!runOneTask())
+            std::this_thread::yield();
+    }
+}
+
+// sortIndices() ordered by chained sort specs
+void ImGuiTableSorter::sortRows(std::vector<int>& rows, const std::vector<ImGuiTableColumnSortSpecs>& specs, const CompareFunc& compare, const std::function<bool()>& cancelled) {
+    sortIndices(rows, [&specs, &compare](int lhs, int rhs) { return rowLess(specs, compare, lhs, rhs); }, cancelled);
+}
+
+// First spec wins, the next ones break ties
+bool ImGuiTableSorter::rowLess(const std::vector<ImGuiTableColumnSortSpecs>& specs, const CompareFunc& compare, int lhs, int rhs) {
+    for (const ImGuiTableColumnSortSpecs& spec : specs) {
+        const int delta = compare(lhs, rhs, spec);
+        if (delta != 0)
+            return spec.SortDirection == ImGuiSortDirection_Descending ? delta > 0 : delta < 0;
+    }
+    return false;
+}
+
+// Constructor
+ImGuiTableSorter::ImGuiTableSorter()
+    : m_rowCount(0)
+    , m_shared(std::make_shared<Shared>())
+    , m_currentGeneration(0)
+{
+    m_shared->generation = 0;
+}
+
+// Destructor: cancel the resort in flight without waiting for it, it only references m_shared
+ImGuiTableSorter::~ImGuiTableSorter() {
+    m_shared->generation++;
+}
+
+// Pick up a finished resort, then start a new one if the sort specs or the row count changed
+void ImGuiTableSorter::updateSpecs(int rowCount, const CompareFunc& compare) {
+    std::shared_ptr<const SortedRows> published = std::atomic_load(&m_shared->published);
+    // By generation: m_current may be a fitted copy of the published order
+    if (published && published->generation > m_currentGeneration) {
+        m_current = published;
+        m_currentGeneration = published->generation;
+    }
+
+    bool dirty = (rowCount != m_rowCount);
+    ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+    if (sortSpecs && sortSpecs->SpecsDirty) {
+        m_specs.assign(sortSpecs->Specs, sortSpecs->Specs + sortSpecs->SpecsCount);
+        sortSpecs->SpecsDirty = false;
+        dirty = true;
+    }
+    if (!dirty)
+        return;
+    m_rowCount = rowCount;
+    fitCurrentRows();
+    startResort(compare);
+}
+
+// Without a core to spare, the resort runs here instead of on the pool, SLICE_BUDGET_US per frame
+void ImGuiTableSorter::update(int rowCount, const CompareFunc& compare) {
+    updateSpecs(rowCount, compare);
+    if (m_sliceSort && stepSliceSort(std::chrono::steady_clock::now() + std::chrono::microseconds(SLICE_BUDGET_US))) {
+        std::shared_ptr<SortedRows> sorted = std::make_shared<SortedRows>();
+        sorted->generation = m_sliceSort->generation;
+        sorted->rows.swap(m_sliceSort->rows);
+        m_current = sorted;
+        m_currentGeneration = sorted->generation;
+        m_sliceSort.reset();
+    }
+}
+
+// Bottom-up merge sort resumed where the last call stopped: runs of MIN_RUN_SIZE rows are sorted first, then pairs of
+// runs are merged MIN_RUN_SIZE rows at a time, checking the deadline in between. True once sorted
+bool ImGuiTableSorter::stepSliceSort(std::chrono::steady_clock::time_point deadline) {
+    SliceSort& sort = *m_sliceSort;
+    auto less = [&sort](int lhs, int rhs) { return rowLess(sort.specs, sort.compare, lhs, rhs); };
+    std::vector<int>& rows = sort.rows;
+    const int count = (int)rows.size();
+    while (sort.width == 0) {
+        if (sort.position >= count) {
+            sort.width = MIN_RUN_SIZE;
+            sort.position = 0;
+            break;
+        }
+        const int end = std::min(sort.position + MIN_RUN_SIZE, count);
+        std::stable_sort(rows.begin() + sort.position, rows.begin() + end, less);
+        sort.position = end;
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+    }
+    while (sort.width < count) {
+        // Pair of runs [lo, mid) + [mid, hi) holding the next output row
+        const int lo = sort.position / (sort.width * 2) * (sort.width * 2);
+        const int mid = std::min(lo + sort.width, count);
+        const int hi = std::min(lo + sort.width * 2, count);
+        if (sort.position == lo) {
+            sort.a = lo;
+            sort.b = mid;
+        }
+        const int end = std::min(sort.position + MIN_RUN_SIZE, hi);
+        int* out = sort.buffer.data();
+        while (sort.position < end) {
+            if (sort.b < hi && (sort.a >= mid || less(rows[sort.b], rows[sort.a])))
+                out[sort.position++] = rows[sort.b++];
+            else
+                out[sort.position++] = rows[sort.a++];
+        }
+        if (sort.position == count) {
+            rows.swap(sort.buffer);
+            sort.width *= 2;
+            sort.position = 0;
+        }
+        if (std::chrono::steady_clock::now() >= deadline)
+            return sort.width >= count;
+    }
+    return true;
+}
+
+// Make the displayed order a permutation of the new row count until the resort is done: rows past it are dropped,
+// new rows go last
+void ImGuiTableSorter::fitCurrentRows() {
+    if (!m_current || (int)m_current->rows.size() == m_rowCount)
+        return;
+    std::shared_ptr<SortedRows> fitted = std::make_shared<SortedRows>();
+    fitted->generation = m_current->generation;
+    fitted->rows.reserve(m_rowCount);
+    for (int row : m_current->rows) {
+        if (row < m_rowCount)
+            fitted->rows.push_back(row);
+    }
+    for (int row = (int)m_current->rows.size(); row < m_rowCount; row++)
+        fitted->rows.push_back(row);
+    m_current = fitted;
+}
+
+// Queue a resort on the pool, or leave it to update() on a single core. Without sort specs the order is the
+// identity, applied right away
+void ImGuiTableSorter::startResort(const CompareFunc& compare) {
+    const int generation = ++m_shared->generation;
+    m_sliceSort.reset();
+    if (m_specs.empty()) {
+        std::lock_guard<std::mutex> lock(m_shared->publishMutex);
+        std::atomic_store(&m_shared->published, std::shared_ptr<const SortedRows>());
+        m_current.reset();
+        m_currentGeneration = generation;
+        return;
+    }
+
+    if (std::thread::hardware_concurrency() <= 1) {
+        m_sliceSort.reset(new SliceSort());
+        m_sliceSort->generation = generation;
+        m_sliceSort->specs = m_specs;
+        m_sliceSort->compare = compare;
+        m_sliceSort->rows.resize(m_rowCount);
+        std::iota(m_sliceSort->rows.begin(), m_sliceSort->rows.end(), 0);
+        m_sliceSort->buffer.resize(m_rowCount);
+        m_sliceSort->width = 0;
+        m_sliceSort->position = 0;
+        m_sliceSort->a = 0;
+        m_sliceSort->b = 0;
+        return;
+    }
+
+    const std::vector<ImGuiTableColumnSortSpecs> specs = m_specs;
+    const int rowCount = m_rowCount;
+    std::shared_ptr<Shared> shared = m_shared;
+    ImGuiWorkerPool::getInstance().submit([shared, generation, specs, rowCount, compare] {
+        auto cancelled = [&shared, generation] { return shared->generation.load() != generation; };
+        std::shared_ptr<SortedRows> sorted;
+        if (!cancelled()) {
+            sorted = std::make_shared<SortedRows>();
+            sorted->generation = generation;
+            sorted->rows.resize(rowCount);
+            std::iota(sorted->rows.begin(), sorted->rows.end(), 0);
+            sortRows(sorted->rows, specs, compare, cancelled);
+        }
+
+        std::lock_guard<std::mutex> lock(shared->publishMutex);
+        if (sorted && !cancelled())
+            std::atomic_store(&shared->published, std::shared_ptr<const SortedRows>(sorted));
+    });
+}
+
+// Current order, identity until the first sort completes
+int ImGuiTableSorter::getRowCount() const {
+    return m_current ? (int)m_current->rows.size() : m_rowCount;
+}
+
+int ImGuiTableSorter::getRow(int index) const {
+    return m_current ? m_current->rows[index] : index;
+}
+
+// Until update() swaps the result in
+bool ImGuiTableSorter::isSorting() const {
+    return m_currentGeneration != m_shared->generation.load();
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "ImGui/imgui.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small fork-join thread pool for background UI work (sorting, filtering)
+ * parallelFor() can be called from any thread, including a pool thread: the caller runs tasks
+ * itself while it waits, so nested use cannot deadlock.
+ */
+class ImGuiWorkerPool {
+public:
+    // Singleton instance, one thread per core minus the render thread
+    static ImGuiWorkerPool& getInstance();
+
+    // Run a task asynchronously
+    void submit(std::function<void()> task);
+
+    // Run fn(0) .. fn(count - 1) in parallel and wait for all of them
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+    int getThreadCount() const;
+
+private:
+    ImGuiWorkerPool();
+    ~ImGuiWorkerPool();
+
+    // Disable copy constructor and assignment
+    ImGuiWorkerPool(const ImGuiWorkerPool&) = delete;
+    ImGuiWorkerPool& operator=(const ImGuiWorkerPool&) = delete;
+
+    // Pop and run one queued task, false if the queue was empty
+    bool runOneTask();
+    void workerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_quit;
+};
+
+/**
+ * Sorted row index for a table with ImGuiTableFlags_Sortable
+ * Keeps a permutation of [0, rowCount) for the current ImGuiTableSortSpecs. When the specs or the row count change,
+ * the permutation is rebuilt with a parallel stable merge sort on ImGuiWorkerPool and swapped in atomically once done.
+ * On a single core there is no thread to hand the work to: update() sorts in slices of at most about 2 ms per frame.
+ * The previous order keeps being displayed meanwhile, fitted to the new row count: rows past it are dropped and new
+ * rows are shown last, so getRow() is always below the row count given to the last update().
+ * The compare function runs on pool threads: it must only read data that is not modified during the resort.
+ * Lifetime: update() copies the compare function, which keeps running after update() returned, possibly for several
+ * frames, and until the next merge pass after the sorter is destroyed (the destructor cancels the resort but does not
+ * wait for it). Never capture locals or the owner of the sorter by reference: capture by value, or share the data with
+ * a std::shared_ptr.
+ * Usage:
+ *   std::shared_ptr<const std::vector<Item>> items = ...;   // Replaced, not modified, when the data changes
+ *   if (ImGui::BeginTable("items", 2, ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY)) {
+ *       ... TableSetupColumn(), TableHeadersRow()
+ *       sorter.update((int)items->size(), [items](int a, int b, const ImGuiTableColumnSortSpecs& spec) { return compareItems(*items, a, b, spec.ColumnIndex); });
+ *       for (int n = 0; n < sorter.getRowCount(); n++) drawItem(*items, sorter.getRow(n));
+ *       ImGui::EndTable();
+ *   }
+ */
+class ImGuiTableSorter {
+public:
+    // Compare two rows on one sort column, ascending, <0 / 0 / >0 like strcmp. Directions and chained specs are applied by the sorter
+    using CompareFunc = std::function<int(int lhs, int rhs, const ImGuiTableColumnSortSpecs& spec)>;
+
+    ImGuiTableSorter();
+    ~ImGuiTableSorter();
+
+    // Call once per frame between BeginTable() and EndTable(). Starts a resort when needed and picks up a finished one
+    void update(int rowCount, const CompareFunc& compare);
+
+    // Current order (identity until the first sort completes)
+    int getRowCount() const;
+    int getRow(int index) const;
+
+    // Whether a resort is running
+    bool isSorting() const;
+
+    // Parallel stable merge sort of an index array on ImGuiWorkerPool, std::stable_sort() on a single core or for small
+    // arrays. Gives up between merge passes once 'cancelled' returns true
+    template <typename Less>
+    static void sortIndices(std::vector<int>& indices, const Less& less, const std::function<bool()>& cancelled = nullptr);
+
+    // sortIndices() ordered by chained sort specs (first spec wins, the next ones break ties)
+    static void sortRows(std::vector<int>& rows, const std::vector<ImGuiTableColumnSortSpecs>& specs, const CompareFunc& compare, const std::function<bool()>& cancelled = nullptr);
+
+private:
+    // Disable copy constructor and assignment
+    ImGuiTableSorter(const ImGuiTableSorter&) = delete;
+    ImGuiTableSorter& operator=(const ImGuiTableSorter&) = delete;
+
+    // Result of one resort
+    struct SortedRows {
+        int generation;
+        std::vector<int> rows;
+    };
+
+    // Resort run by update() in slices when there is no core to spare
+    struct SliceSort {
+        int generation;
+        std::vector<ImGuiTableColumnSortSpecs> specs;
+        CompareFunc compare;
+        std::vector<int> rows;
+        std::vector<int> buffer;
+        int width;          // Length of the sorted runs being merged, 0 while the first runs are sorted
+        int position;       // Next row of the current pass
+        int a;              // Merge cursors in the current pair of runs
+        int b;
+    };
+
+    // State shared with the resorts in flight. They hold a reference to it, so the destructor only cancels them and
+    // never waits: it can run during static destruction, when the pool threads may already be gone
+    struct Shared {
+        std::atomic<int> generation;
+        std::mutex publishMutex;
+        std::shared_ptr<const SortedRows> published;    // Written by the pool with std::atomic_store()
+    };
+
+    // Below this many rows per run, splitting the sort costs more than it saves
+    static const int MIN_RUN_SIZE = 2048;
+
+    template <typename Less>
+    static int mergeSplit(const int* a, int aCount, const int* b, int bCount, int k, const Less& less);
+    static bool rowLess(const std::vector<ImGuiTableColumnSortSpecs>& specs, const CompareFunc& compare, int lhs, int rhs);
+
+    void updateSpecs(int rowCount, const CompareFunc& compare);
+    void startResort(const CompareFunc& compare);
+    void fitCurrentRows();
+    bool stepSliceSort(std::chrono::steady_clock::time_point deadline);
+
+    std::vector<ImGuiTableColumnSortSpecs> m_specs;
+    int m_rowCount;
+    std::shared_ptr<Shared> m_shared;
+    std::shared_ptr<const SortedRows> m_current;        // Order used by the UI, NULL for the identity
+    int m_currentGeneration;
+    std::unique_ptr<SliceSort> m_sliceSort;
+};
+
+// Number of elements of 'a' among the first 'k' outputs of a stable merge of a and b (merge path partition)
+template <typename Less>
+int ImGuiTableSorter::mergeSplit(const int* a, int aCount, const int* b, int bCount, int k, const Less& less) {
+    int lo = std::max(0, k - bCount);
+    int hi = std::min(k, aCount);
+    while (lo < hi) {
+        const int i = (lo + hi) / 2;
+        const int j = k - i;
+        if (j > 0 && !less(b[j - 1], a[i]))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+// Sort 'runs' slices in parallel, then merge them pairwise. Each merge is split in independent segments along
+// the merge path, so the last passes (few long merges) still use every thread. A template so that 'less' is inlined
+// in the run sorts and merges like in a plain std::stable_sort()
+template <typename Less>
+void ImGuiTableSorter::sortIndices(std::vector<int>& indices, const Less& less, const std::function<bool()>& cancelled) {
+    const int count = (int)indices.size();
+    const int cores = (int)std::thread::hardware_concurrency();
+    if (cores <= 1 || count / 2 < MIN_RUN_SIZE) {
+        std::stable_sort(indices.begin(), indices.end(), less);
+        return;
+    }
+    ImGuiWorkerPool& pool = ImGuiWorkerPool::getInstance();
+    const int taskCount = std::min(pool.getThreadCount() + 1, cores);
+    int runs = 1;
+    while (runs < taskCount * 2 && count / (runs * 2) >= MIN_RUN_SIZE)
+        runs *= 2;
+
+    std::vector<int> bounds(runs + 1);
+    for (int n = 0; n <= runs; n++)
+        bounds[n] = (int)((long long)count * n / runs);
+    pool.parallelFor(runs, [&](int run) {
+        std::stable_sort(indices.begin() + bounds[run], indices.begin() + bounds[run + 1], less);
+    });
+
+    std::vector<int> buffer(count);
+    int* src = indices.data();
+    int* dst = buffer.data();
+    for (int width = 1; width < runs; width *= 2) {
+        if (cancelled && cancelled())
+            return;
+        const int pairCount = runs / (width * 2);
+        const int segmentCount = std::max(1, taskCount / pairCount);
+        pool.parallelFor(pairCount * segmentCount, [&](int task) {
+            const int pair = task / segmentCount;
+            const int segment = task % segmentCount;
+            const int lo = bounds[pair * width * 2];
+            const int mid = bounds[pair * width * 2 + width];
+            const int hi = bounds[pair * width * 2 + width * 2];
+            const int* a = src + lo;
+            const int* b = src + mid;
+            const int aCount = mid - lo;
+            const int bCount = hi - mid;
+            const int k0 = (int)((long long)(hi - lo) * segment / segmentCount);
+            const int k1 = (int)((long long)(hi - lo) * (segment + 1) / segmentCount);
+            const int i0 = mergeSplit(a, aCount, b, bCount, k0, less);
+            const int i1 = mergeSplit(a, aCount, b, bCount, k1, less);
+            std::merge(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), dst + lo + k0, less);
+        });
+        std::swap(src, dst);
+    }
+    if (src != indices.data())
+        indices.swap(buffer);
+}
@@ -0,0 +1,338 @@
+#include "ImGuiVirtualTable.h"
+#include "ImGuiTableSorter.h"
+#include "ImGui/imgui_internal.h"
+#include <cstring>
+#include <numeric>
+
+// Rows between two cancellation checks while filtering
+static const int CANCEL_CHECK_ROWS = 4096;
+
+// Build the Fenwick tree in O(N) (1-based, m_tree[0] unused)
+void ImGuiVirtualTable::HeightTree::build(const std::vector<float>& heights) {
+    m_size = (int)heights.size();
+    m_tree.assign(m_size + 1, 0.0);
+    for (int i = 1; i <= m_size; i++) {
+        m_tree[i] += heights[i - 1];
+        const int parent = i + (i & -i);
+        if (parent <= m_size)
+            m_tree[parent] += m_tree[i];
+    }
+}
+
+// New last row: its node sums the nodes it covers, (i - lowbit(i), i]
+void ImGuiVirtualTable::HeightTree::append(double height) {
+    if (m_tree.empty())
+        m_tree.push_back(0.0);
+    const int index = ++m_size;
+    for (int i = index - 1; i > index - (index & -index); i -= i & -i)
+        height += m_tree[i];
+    m_tree.push_back(height);
+}
+
+void ImGuiVirtualTable::HeightTree::add(int index, double delta) {
+    for (int i = index + 1; i <= m_size; i += i & -i)
+        m_tree[i] += delta;
+}
+
+double ImGuiVirtualTable::HeightTree::prefix(int index) const {
+    double sum = 0.0;
+    for (int i = index; i > 0; i -= i & -i)
+        sum += m_tree[i];
+    return sum;
+}
+
+// Binary descent: largest index whose prefix sum is <= offset
+int ImGuiVirtualTable::HeightTree::find(double offset) const {
+    int step = 1;
+    while (step * 2 <= m_size)
+        step *= 2;
+    int pos = 0;
+    for (; step > 0; step >>= 1) {
+        if (pos + step <= m_size && m_tree[pos + step] <= offset) {
+            pos += step;
+            offset -= m_tree[pos];
+        }
+    }
+    return pos < m_size ? pos : m_size - 1;
+}
+
+// Constructor
+ImGuiVirtualTable::ImGuiVirtualTable(ImGuiTableDataSource* source)
+    : m_source(source)
+    , m_viewRowCount(0)
+    , m_sourceRowCount(0)
+    , m_jobRowCount(0)
+    , m_appendQueued(false)
+    , m_generation(0)
+    , m_appliedGeneration(0)
+    , m_quit(false)
+{
+    m_filter[0] = 0;
+    m_worker = std::thread(&ImGuiVirtualTable::workerLoop, this);
+}
+
+// Destructor
+ImGuiVirtualTable::~ImGuiVirtualTable() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        m_generation++; // Cancel the job in flight
+    }
+    m_condition.notify_one();
+    m_worker.join();
+}
+
+// Filter with ImGuiTextFilter syntax, empty to show every row
+void ImGuiVirtualTable::setFilter(const char* filter) {
+    if (strcmp(m_filter, filter) == 0)
+        return;
+    strncpy(m_filter, filter, sizeof(m_filter) - 1);
+    m_filter[sizeof(m_filter) - 1] = 0;
+    requestRebuild();
+}
+
+// Schedule a rebuild after the data changed
+void ImGuiVirtualTable::invalidate() {
+    requestRebuild();
+}
+
+int ImGuiVirtualTable::getViewRowCount() const {
+    return m_viewRowCount;
+}
+
+int ImGuiVirtualTable::getViewRow(int viewIndex) const {
+    return m_order.empty() ? viewIndex : m_order[viewIndex];
+}
+
+bool ImGuiVirtualTable::isRebuilding() const {
+    return m_appliedGeneration != m_generation.load();
+}
+
+// Without filter or sort the view is every row in source order: apply it right away. Otherwise hand a job to the worker
+void ImGuiVirtualTable::requestRebuild() {
+    m_appendQueued = false;
+    if (m_filter[0] == 0 && m_sortSpecs.empty()) {
+        m_order.clear();
+        m_viewRowCount = m_sourceRowCount;
+        m_jobRowCount = m_sourceRowCount;
+        m_appliedGeneration = ++m_generation;
+        rebuildHeightTree();
+        return;
+    }
+    postJob(0);
+}
+
+// Rows were added at the end of the source, the rows already in the view are unchanged
+void ImGuiVirtualTable::appendRows() {
+    if (m_filter[0] == 0 && m_sortSpecs.empty() && !isRebuilding()) {
+        // The view is every row in source order: extend it
+        const float defaultHeight = ImGui::GetTextLineHeight() + ImGui::GetStyle().CellPadding.y * 2.0f;
+        for (int row = m_viewRowCount; row < m_sourceRowCount; row++)
+            m_heightTree.append(getKnownRowHeight(row, defaultHeight));
+        m_viewRowCount = m_sourceRowCount;
+        m_jobRowCount = m_sourceRowCount;
+        return;
+    }
+    // Let the job in flight finish, the rows it doesn't cover are picked up when it is applied
+    if (isRebuilding()) {
+        m_appendQueued = true;
+        return;
+    }
+    // A sorted view needs the new rows merged everywhere: one full job. A filtered view only filters the new rows
+    m_appendQueued = false;
+    postJob(m_sortSpecs.empty() ? m_jobRowCount : 0);
+}
+
+// Hand rows [firstRow, m_sourceRowCount) to the worker. Cancels the job in flight, if any
+void ImGuiVirtualTable::postJob(int firstRow) {
+    std::unique_ptr<Job> job(new Job());
+    job->generation = ++m_generation;
+    job->firstRow = firstRow;
+    job->rowCount = m_sourceRowCount;
+    m_jobRowCount = m_sourceRowCount;
+    ImStrncpy(job->filter.InputBuf, m_filter, IM_ARRAYSIZE(job->filter.InputBuf));
+    job->filter.Build();
+    job->filterActive = job->filter.IsActive();
+    job->sortSpecs = m_sortSpecs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingJob.swap(job);
+    }
+    m_condition.notify_one();
+    // A job that was still pending is released here, on the UI thread
+}
+
+// [Worker thread] Filter, then parallel stable sort on the chained sort specs. Gives up as soon as a newer job is requested
+void ImGuiVirtualTable::runJob(Job& job) const {
+    job.order.clear();
+    if (job.filterActive) {
+        for (int row = job.firstRow; row < job.rowCount; row++) {
+            if ((row - job.firstRow) % CANCEL_CHECK_ROWS == 0 && m_generation.load(std::memory_order_relaxed) != job.generation)
+                return;
+            if (m_source->passFilter(row, job.filter))
+                job.order.push_back(row);
+        }
+    } else {
+        job.order.resize(job.rowCount - job.firstRow);
+        std::iota(job.order.begin(), job.order.end(), job.firstRow);
+    }
+
+    if (job.sortSpecs.empty() || m_generation.load(std::memory_order_relaxed) != job.generation)
+        return;
+    const ImGuiTableDataSource* source = m_source;
+    ImGuiTableSorter::sortRows(job.order, job.sortSpecs,
+        [source](int lhs, int rhs, const ImGuiTableColumnSortSpecs& spec) { return source->compareRows(lhs, rhs, spec); },
+        [this, &job] { return m_generation.load(std::memory_order_relaxed) != job.generation; });
+}
+
+// Worker thread main loop
+void ImGuiVirtualTable::workerLoop() {
+    for (;;) {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_quit || m_pendingJob; });
+            if (m_quit)
+                return;
+            job = std::move(m_pendingJob);
+        }
+        runJob(*job);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finishedJobs.push_back(std::move(job));
+    }
+}
+
+// Swap in the result of the latest job, drop stale ones
+void ImGuiVirtualTable::applyFinishedJobs() {
+    std::vector<std::unique_ptr<Job>> finishedJobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_finishedJobs.empty())
+            return;
+        finishedJobs.swap(m_finishedJobs);
+    }
+    for (std::unique_ptr<Job>& job : finishedJobs) {
+        if (job->generation != m_generation.load())
+            continue;
+        m_appliedGeneration = job->generation;
+        if (job->firstRow == 0) {
+            m_order.swap(job->order);
+            m_viewRowCount = (int)m_order.size();
+            rebuildHeightTree();
+        } else {
+            // Appended rows that passed the filter go after the current view
+            const float defaultHeight = ImGui::GetTextLineHeight() + ImGui::GetStyle().CellPadding.y * 2.0f;
+            for (int row : job->order)
+                m_heightTree.append(getKnownRowHeight(row, defaultHeight));
+            m_order.insert(m_order.end(), job->order.begin(), job->order.end());
+            m_viewRowCount = (int)m_order.size();
+        }
+    }
+    if (m_appendQueued && !isRebuilding())
+        appendRows();
+}
+
+// O(N), only when the view changes. Rows never displayed use the source estimate
+void ImGuiVirtualTable::rebuildHeightTree() {
+    const float defaultHeight = ImGui::GetTextLineHeight() + ImGui::GetStyle().CellPadding.y * 2.0f;
+    m_rowHeights.resize(m_sourceRowCount, -1.0f);
+
+    std::vector<float> viewHeights(m_viewRowCount);
+    for (int n = 0; n < m_viewRowCount; n++) {
+        const int row = getViewRow(n);
+        viewHeights[n] = row < m_sourceRowCount ? getKnownRowHeight(row, defaultHeight) : defaultHeight;
+    }
+    m_heightTree.build(viewHeights);
+}
+
+// Measured height of a source row, or its estimate if it was never displayed (m_rowHeights must cover the row)
+float ImGuiVirtualTable::getKnownRowHeight(int row, float defaultHeight) {
+    float& height = m_rowHeights[row];
+    if (height < 0.0f) {
+        height = m_source->getRowHeight(row);
+        if (height <= 0.0f)
+            height = defaultHeight;
+    }
+    return height;
+}
+
+// Submit the visible rows only, with the cursor seeked over the rows above and below
+void ImGuiVirtualTable::drawRows() {
+    ImGuiTable* table = ImGui::GetCurrentTable();
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (table->IsInsideRow)
+        ImGui::TableEndRow(table);
+
+    // Position of the first row when scrolled (the frozen header row was unfrozen by TableEndRow)
+    const float bodyY = table->RowPosY2;
+    int first = 0, last = 0;
+    if (m_viewRowCount > 0) {
+        first = m_heightTree.find(ImMax(window->ClipRect.Min.y - bodyY, 0.0f));
+        last = m_heightTree.find(ImMax(window->ClipRect.Max.y - bodyY, 0.0f)) + 1;
+    }
+
+    const float startY = bodyY + (float)m_heightTree.prefix(first);
+    window->DC.CursorPos.y = startY;
+    table->RowPosY2 = startY;
+    table->RowBgColorCounter += first; // Keep alternating row colors stable while scrolling
+
+    for (int n = first; n < last; n++) {
+        const int row = getViewRow(n);
+        ImGui::TableNextRow();
+        if (row >= m_sourceRowCount)
+            continue; // Row removed, the new view is not ready yet
+        ImGui::PushID(row);
+        m_source->drawRow(row);
+        ImGui::PopID();
+        ImGui::TableEndRow(table);
+
+        // Learn the real height, rows below shift accordingly from the next frame
+        const float height = table->RowPosY2 - table->RowPosY1;
+        float& knownHeight = m_rowHeights[row];
+        if (ImFabs(height - knownHeight) > 0.01f) {
+            m_heightTree.add(n, (double)height - knownHeight);
+            knownHeight = height;
+        }
+    }
+    if (table->IsInsideRow)
+        ImGui::TableEndRow(table);
+
+    // Seek to the end of the list so the scrollbar covers every row
+    const float endY = bodyY + (float)m_heightTree.total();
+    window->DC.CursorPos.y = endY;
+    window->DC.CursorMaxPos.y = ImMax(window->DC.CursorMaxPos.y, endY);
+    table->RowPosY2 = endY;
+}
+
+// BeginTable(), headers, visible rows, EndTable()
+bool ImGuiVirtualTable::draw(const char* strId, ImGuiTableFlags flags, const ImVec2& outerSize) {
+    const int rowCount = m_source->getRowCount();
+    if (rowCount > m_sourceRowCount) {
+        m_sourceRowCount = rowCount;
+        m_rowHeights.resize(m_sourceRowCount, -1.0f);
+        appendRows();
+    } else if (rowCount < m_sourceRowCount) {
+        m_sourceRowCount = rowCount;
+        requestRebuild();
+    }
+    applyFinishedJobs();
+
+    if (!ImGui::BeginTable(strId, m_source->getColumnCount(), flags | ImGuiTableFlags_ScrollY, outerSize))
+        return false;
+
+    m_source->setupColumns();
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableHeadersRow();
+
+    if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs()) {
+        if (sortSpecs->SpecsDirty) {
+            m_sortSpecs.assign(sortSpecs->Specs, sortSpecs->Specs + sortSpecs->SpecsCount);
+            sortSpecs->SpecsDirty = false;
+            requestRebuild();
+        }
+    }
+
+    drawRows();
+    ImGui::EndTable();
+    return true;
+}
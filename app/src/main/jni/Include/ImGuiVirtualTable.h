@@ -0,0 +1,136 @@
+#pragma once
+
+#include "ImGui/imgui.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Data source for ImGuiVirtualTable
+ * Rows are only fetched through drawRow() while they are visible. passFilter() and compareRows() run on the
+ * table worker thread: they must only read data that is not modified while a rebuild is running
+ * (modify it between frames and call ImGuiVirtualTable::invalidate()). Rows may be appended at any time as long as the
+ * existing ones stay in place (e.g. std::deque, or a reserved std::vector).
+ */
+class ImGuiTableDataSource {
+public:
+    virtual ~ImGuiTableDataSource() = default;
+
+    // Number of rows, polled every frame. Rows appended at the end are added to the view incrementally, any other change schedules a rebuild
+    virtual int getRowCount() const = 0;
+
+    // Number of columns passed to ImGui::BeginTable()
+    virtual int getColumnCount() const = 0;
+
+    // Declare the columns with ImGui::TableSetupColumn()
+    virtual void setupColumns() = 0;
+
+    // Submit the cells of one visible row with ImGui::TableSetColumnIndex() / ImGui::TableNextColumn()
+    virtual void drawRow(int row) = 0;
+
+    // Height estimate for a row that was never displayed, <= 0 for the default text row height. Replaced by the measured height once displayed
+    virtual float getRowHeight(int /*row*/) const { return 0.0f; }
+
+    // [Worker thread] Whether the row passes the filter (only called while a filter is set)
+    virtual bool passFilter(int /*row*/, const ImGuiTextFilter& /*filter*/) const { return true; }
+
+    // [Worker thread] Compare two rows on one sort column, ascending, <0 / 0 / >0 like strcmp. The table applies the direction and chains the sort specs
+    virtual int compareRows(int /*lhs*/, int /*rhs*/, const ImGuiTableColumnSortSpecs& /*spec*/) const { return 0; }
+};
+
+/**
+ * Virtualized table for very large data sets
+ * Like ImGuiListClipper, only the visible rows are submitted, but rows may have different heights: they are kept in a
+ * Fenwick tree in view order, so locating the first visible row and updating a measured height are O(log N).
+ * Filtering runs on a worker thread and sorting on ImGuiWorkerPool (see ImGuiTableSorter). The previous view keeps
+ * being displayed until the new one is ready, and a newer request cancels the one in flight.
+ * Appended rows don't restart anything: without filter/sort they extend the view in O(log N) per row, with a filter only the
+ * new rows are filtered, and at most one follow-up job is queued while another one is running.
+ */
+class ImGuiVirtualTable {
+public:
+    explicit ImGuiVirtualTable(ImGuiTableDataSource* source);
+    ~ImGuiVirtualTable();
+
+    // BeginTable(), headers, visible rows, EndTable(). ImGuiTableFlags_ScrollY is always added
+    bool draw(const char* strId, ImGuiTableFlags flags = 0, const ImVec2& outerSize = ImVec2(0, 0));
+
+    // Filter with ImGuiTextFilter syntax ("aaa,-bbb"), empty to show every row
+    void setFilter(const char* filter);
+
+    // Schedule a rebuild of the view after the data changed (row count changes are detected automatically)
+    void invalidate();
+
+    // Rows in the current view, and the source row displayed at a view index
+    int getViewRowCount() const;
+    int getViewRow(int viewIndex) const;
+
+    // Whether a filter/sort is still running on the worker thread
+    bool isRebuilding() const;
+
+private:
+    // Disable copy constructor and assignment
+    ImGuiVirtualTable(const ImGuiVirtualTable&) = delete;
+    ImGuiVirtualTable& operator=(const ImGuiVirtualTable&) = delete;
+
+    // Prefix sums of row heights in view order
+    class HeightTree {
+    public:
+        void build(const std::vector<float>& heights);
+        void append(double height);         // O(log N)
+        void add(int index, double delta);
+        double prefix(int index) const;     // Sum of heights [0, index)
+        int find(double offset) const;      // Index of the row containing 'offset'
+        double total() const { return prefix(m_size); }
+    private:
+        std::vector<double> m_tree;
+        int m_size = 0;
+    };
+
+    // One filter/sort request, built on the UI thread and processed on the worker thread
+    // Rows [firstRow, rowCount) are processed: firstRow > 0 only for appended rows of a filtered, unsorted view
+    struct Job {
+        int generation;
+        int firstRow;
+        int rowCount;
+        bool filterActive;
+        ImGuiTextFilter filter;
+        std::vector<ImGuiTableColumnSortSpecs> sortSpecs;
+        std::vector<int> order;
+    };
+
+    void requestRebuild();
+    void appendRows();
+    void postJob(int firstRow);
+    void runJob(Job& job) const;
+    void workerLoop();
+    void applyFinishedJobs();
+    void rebuildHeightTree();
+    float getKnownRowHeight(int row, float defaultHeight);
+    void drawRows();
+
+    ImGuiTableDataSource* m_source;
+    char m_filter[256];
+    std::vector<ImGuiTableColumnSortSpecs> m_sortSpecs;
+
+    // Current view: m_order maps view index to source row, empty when the view is every row in source order
+    std::vector<int> m_order;
+    int m_viewRowCount;
+    int m_sourceRowCount;
+    int m_jobRowCount;                  // Source rows covered by the current view plus the job in flight
+    bool m_appendQueued;                // Rows were appended while a job was in flight
+    std::vector<float> m_rowHeights;    // By source row
+    HeightTree m_heightTree;
+
+    std::thread m_worker;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::unique_ptr<Job> m_pendingJob;
+    std::vector<std::unique_ptr<Job>> m_finishedJobs;   // Destroyed on the UI thread (ImGuiTextFilter allocates through ImGui)
+    std::atomic<int> m_generation;
+    int m_appliedGeneration;
+    bool m_quit;
+};
@@ -0,0 +1,119 @@
+#include "MonotonicArena.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Chunk data starts after the header, aligned like malloc()
+static const size_t HEADER_SIZE = (sizeof(void*) * 2 + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+static thread_local MonotonicArena* s_current = nullptr;
+
+// Scope constructor
+MonotonicArena::Scope::Scope(MonotonicArena& arena)
+    : m_previous(s_current)
+{
+    s_current = &arena;
+}
+
+// Scope destructor
+MonotonicArena::Scope::~Scope() {
+    s_current = m_previous;
+}
+
+MonotonicArena* MonotonicArena::getCurrent() {
+    return s_current;
+}
+
+// Constructor
+MonotonicArena::MonotonicArena(size_t chunkSize)
+    : m_chunks(nullptr)
+    , m_cursor(nullptr)
+    , m_end(nullptr)
+    , m_chunkSize(chunkSize)
+    , m_bytesUsed(0)
+    , m_bytesReserved(0)
+    , m_chunkCount(0)
+{
+}
+
+// Destructor
+MonotonicArena::~MonotonicArena() {
+    while (m_chunks) {
+        Chunk* next = m_chunks->next;
+        free(m_chunks);
+        m_chunks = next;
+    }
+}
+
+void* MonotonicArena::allocate(size_t size, size_t alignment) {
+    char* aligned = (char*)(((uintptr_t)m_cursor + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    if (!m_cursor || aligned > m_end || size > (size_t)(m_end - aligned))
+        return allocateChunk(size, alignment);
+    m_cursor = aligned + size;
+    m_bytesUsed += size;
+    return aligned;
+}
+
+// Start a new chunk as large as all the previous ones (at least chunkSize), or the allocation if larger: the chunk
+// count stays logarithmic in the size of the content, which keeps owns() short
+void* MonotonicArena::allocateChunk(size_t size, size_t alignment) {
+    const size_t padding = alignment > alignof(std::max_align_t) ? alignment : 0;
+    size_t dataSize = m_bytesReserved > m_chunkSize ? m_bytesReserved : m_chunkSize;
+    if (size + padding > dataSize) dataSize = size + padding;
+    Chunk* chunk = (Chunk*)malloc(HEADER_SIZE + dataSize);
+    if (!chunk) throw std::bad_alloc();
+    chunk->size = dataSize;
+    chunk->next = m_chunks;
+    m_chunks = chunk;
+    m_chunkCount++;
+    m_bytesReserved += dataSize;
+
+    m_cursor = (char*)chunk + HEADER_SIZE;
+    m_end = m_cursor + dataSize;
+    return allocate(size, alignment);
+}
+
+char* MonotonicArena::copyString(const char* text, size_t length) {
+    char* copy = (char*)allocate(length + 1, 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+// Keep the first chunk (the last in the list): a reloaded document of the same size fits in the same memory when
+// the chunk size was chosen for it
+void MonotonicArena::reset() {
+    while (m_chunks && m_chunks->next) {
+        Chunk* next = m_chunks->next;
+        m_bytesReserved -= m_chunks->size;
+        m_chunkCount--;
+        free(m_chunks);
+        m_chunks = next;
+    }
+    m_cursor = m_chunks ? (char*)m_chunks + HEADER_SIZE : nullptr;
+    m_end = m_chunks ? m_cursor + m_chunks->size : nullptr;
+    m_bytesUsed = 0;
+}
+
+// Most recent chunk first, frees usually come from the latest allocations
+bool MonotonicArena::owns(const void* p) const {
+    for (const Chunk* chunk = m_chunks; chunk; chunk = chunk->next) {
+        const char* data = (const char*)chunk + HEADER_SIZE;
+        if (p >= data && p < data + chunk->size)
+            return true;
+    }
+    return false;
+}
+
+size_t MonotonicArena::getBytesUsed() const {
+    return m_bytesUsed;
+}
+
+size_t MonotonicArena::getBytesReserved() const {
+    return m_bytesReserved;
+}
+
+int MonotonicArena::getChunkCount() const {
+    return m_chunkCount;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Bump allocator over large chunks, freed all at once
+ * allocate() moves a pointer inside the current chunk and starts a new chunk when it is full, as large as all the
+ * previous ones together (chunkSize for the first), or the allocation size if larger. Nothing is freed individually:
+ * reset() forgets every allocation and keeps the first chunk for the next use, the destructor returns the chunks to
+ * the system. Not thread-safe.
+ * A Scope makes the arena current on its thread, for allocators that cannot carry state (see ArenaJson.h).
+ */
+class MonotonicArena {
+public:
+    /**
+     * Makes an arena the current one of the thread until the end of the block, then restores the previous one
+     */
+    class Scope {
+    public:
+        explicit Scope(MonotonicArena& arena);
+        ~Scope();
+
+    private:
+        // Disable copy constructor and assignment
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        MonotonicArena* m_previous;
+    };
+
+    explicit MonotonicArena(size_t chunkSize = 1 << 20);
+    ~MonotonicArena();
+
+    // Uninitialized memory, valid until reset() or the destructor. 'alignment' must be a power of two
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Copy of 'length' bytes of 'text', '\0' terminated
+    char* copyString(const char* text, size_t length);
+
+    // Forget every allocation. The first chunk is kept, the others are freed
+    void reset();
+
+    // Whether 'p' points in one of the chunks
+    bool owns(const void* p) const;
+
+    // Arena of the innermost Scope of the calling thread, NULL outside of any
+    static MonotonicArena* getCurrent();
+
+    // Bytes handed out since the last reset, bytes reserved from the system, chunks
+    size_t getBytesUsed() const;
+    size_t getBytesReserved() const;
+    int getChunkCount() const;
+
+private:
+    // Disable copy constructor and assignment
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // Chunk header, the memory follows it
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    void* allocateChunk(size_t size, size_t alignment);
+
+    Chunk* m_chunks;        // Most recent first, the first chunk allocated is last
+    char* m_cursor;
+    char* m_end;
+    size_t m_chunkSize;
+    size_t m_bytesUsed;
+    size_t m_bytesReserved;
+    int m_chunkCount;
+};
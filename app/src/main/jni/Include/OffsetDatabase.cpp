@@ -0,0 +1,451 @@
+#include "OffsetDatabase.h"
+#include "json/json.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+// Records and signatures of a typical database fit in a few chunks
+static const size_t ARENA_CHUNK_SIZE = 1 << 20;
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * nlohmann::json SAX handler filling an OffsetDatabase
+ * Tracks the nesting depth: 1 is the root object, 2 the "modules" / "entries" arrays, 3 the fields of an entry.
+ * Values the format does not know (or nested deeper) are skipped as a whole.
+ */
+class OffsetDatabaseSax {
+public:
+    typedef nlohmann::json json;
+
+    explicit OffsetDatabaseSax(OffsetDatabase& database)
+        : m_database(database)
+        , m_depth(0)
+        , m_skipDepth(0)
+        , m_section(SectionNone)
+        , m_field(FieldNone)
+        , m_entryCount(0)
+        , m_maxModuleIndex(-1)
+    {
+        resetEntry();
+    }
+
+    const std::string& getError() const { return m_error; }
+
+    // Once the whole text is read, as "modules" may come after "entries": module indices must be in "modules", and
+    // module names become indices, after the listed modules
+    bool resolveModules() {
+        std::vector<const char*>& modules = m_database.m_modules;
+        if (m_maxModuleIndex >= (int)modules.size()) {
+            m_error = "module index out of range";
+            return false;
+        }
+        std::vector<uint16_t> indices(m_moduleNames.size());
+        for (size_t n = 0; n < m_moduleNames.size(); n++) {
+            const int index = addModule(m_moduleNames[n]);
+            if (index > 0xFFFF) {
+                m_error = "too many modules";
+                return false;
+            }
+            indices[n] = (uint16_t)index;
+        }
+        for (OffsetRecord* record : m_namedModuleRecords)
+            record->module = indices[record->module];
+        return true;
+    }
+
+    bool null() { return scalar(); }
+    bool boolean(bool) { return scalar(); }
+    bool number_integer(json::number_integer_t value) { return value < 0 ? (isEntryField() ? fail("negative number") : scalar()) : number((uint64_t)value); }
+    bool number_unsigned(json::number_unsigned_t value) { return number(value); }
+    bool number_float(json::number_float_t, const json::string_t&) { return isEntryField() ? fail("fractional number") : scalar(); }
+    bool binary(json::binary_t&) { return scalar(); }
+
+    bool string(json::string_t& value) {
+        if (m_skipDepth) return true;
+        if (m_depth == 2 && m_section == SectionModules) {
+            // Kept as listed, duplicates included: entries refer to them by position
+            m_database.m_modules.push_back(m_database.m_arena.copyString(value.data(), value.size()));
+            return true;
+        }
+        if (!isEntryField()) return scalar();
+        switch (m_field) {
+        case FieldName:
+            m_nameHash = OffsetDatabase::hashName(value.data(), value.size());
+            m_hasName = true;
+            break;
+        case FieldModule:
+            m_module = moduleNameIndex(value);
+            m_moduleIsName = true;
+            m_hasModule = true;
+            break;
+        case FieldOffset: {
+            char* end = nullptr;
+            errno = 0;
+            m_offset = strtoull(value.c_str(), &end, 0);
+            if (value.empty() || *end || errno) return fail("invalid offset");
+            m_hasOffset = true;
+            break;
+        }
+        case FieldSignature:
+            if (!parseSignature(value)) return fail("invalid signature");
+            break;
+        default:
+            break;
+        }
+        m_field = FieldNone;
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        if (!m_skipDepth) {
+            if (m_depth == 0) {
+                m_depth++;
+                return true;
+            }
+            if (!(m_depth == 2 && m_section == SectionEntries))
+                m_skipDepth = m_depth + 1;
+        }
+        m_depth++;
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (m_depth == 0) return failRoot();
+        if (!m_skipDepth && !(m_depth == 1 && (m_section == SectionModules || m_section == SectionEntries)))
+            m_skipDepth = m_depth + 1;
+        m_depth++;
+        return true;
+    }
+
+    bool end_object() {
+        const bool entry = !m_skipDepth && m_depth == 3 && m_section == SectionEntries;
+        endContainer();
+        return entry ? addEntry() : true;
+    }
+
+    bool end_array() {
+        endContainer();
+        return true;
+    }
+
+    bool key(json::string_t& value) {
+        if (m_skipDepth) return true;
+        if (m_depth == 1) {
+            m_section = value == "modules" ? SectionModules : value == "entries" ? SectionEntries : SectionOther;
+        } else if (m_depth == 3) {
+            m_field = value == "name" ? FieldName : value == "module" ? FieldModule : value == "offset" ? FieldOffset
+                    : value == "signature" ? FieldSignature : FieldNone;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& exception) {
+        m_error = exception.what();
+        return false;
+    }
+
+private:
+    enum Section {
+        SectionNone,
+        SectionModules,
+        SectionEntries,
+        SectionOther
+    };
+
+    enum Field {
+        FieldNone,
+        FieldName,
+        FieldModule,
+        FieldOffset,
+        FieldSignature
+    };
+
+    // A value of a field of an entry (not inside a skipped value)
+    bool isEntryField() const {
+        return !m_skipDepth && m_depth == 3 && m_section == SectionEntries && m_field != FieldNone;
+    }
+
+    bool scalar() {
+        if (m_depth == 0) return failRoot();
+        if (!m_skipDepth && m_depth == 3) m_field = FieldNone;
+        return true;
+    }
+
+    bool number(uint64_t value) {
+        if (!isEntryField()) return scalar();
+        if (m_field == FieldOffset) {
+            m_offset = value;
+            m_hasOffset = true;
+        } else if (m_field == FieldModule) {
+            if (value > 0xFFFF) return fail("invalid module");
+            m_module = (int)value;
+            m_moduleIsName = false;
+            m_hasModule = true;
+        } else {
+            return fail("number instead of a string");
+        }
+        m_field = FieldNone;
+        return true;
+    }
+
+    void endContainer() {
+        if (m_skipDepth == m_depth) m_skipDepth = 0;
+        m_depth--;
+        if (!m_skipDepth && m_depth == 3) m_field = FieldNone;
+        if (!m_skipDepth && m_depth == 1) m_section = SectionNone;
+    }
+
+    bool failRoot() {
+        m_error = "the root must be an object";
+        return false;
+    }
+
+    bool fail(const char* message) {
+        m_error = std::string("entry ") + std::to_string(m_entryCount) + ": " + message;
+        return false;
+    }
+
+    // Index of a module name used by entries in m_moduleNames, added if it is new. A database has a handful of modules
+    int moduleNameIndex(const std::string& name) {
+        for (size_t n = 0; n < m_moduleNames.size(); n++)
+            if (name == m_moduleNames[n]) return (int)n;
+        m_moduleNames.push_back(name);
+        return (int)m_moduleNames.size() - 1;
+    }
+
+    // Index of a module, added if it is not listed
+    int addModule(const std::string& name) {
+        std::vector<const char*>& modules = m_database.m_modules;
+        for (size_t n = 0; n < modules.size(); n++)
+            if (name == modules[n]) return (int)n;
+        modules.push_back(m_database.m_arena.copyString(name.data(), name.size()));
+        return (int)modules.size() - 1;
+    }
+
+    // "FF 43 ?? D1": bytes then mask, in the arena. Decoded in one pass into reused buffers, then copied
+    bool parseSignature(const std::string& text) {
+        m_signatureBytes.clear();
+        m_signatureMask.clear();
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end) {
+            if (*p == ' ') {
+                p++;
+                continue;
+            }
+            const char* token = p;
+            while (p < end && *p != ' ') p++;
+            const size_t length = (size_t)(p - token);
+            if (token[0] == '?' && (length == 1 || (length == 2 && token[1] == '?'))) {
+                m_signatureBytes.push_back(0);
+                m_signatureMask.push_back(0x00);
+                continue;
+            }
+            const int high = length == 2 ? hexDigit(token[0]) : -1;
+            const int low = length == 2 ? hexDigit(token[1]) : -1;
+            if (high < 0 || low < 0) return false;
+            m_signatureBytes.push_back((uint8_t)(high * 16 + low));
+            m_signatureMask.push_back(0xFF);
+        }
+        const size_t count = m_signatureBytes.size();
+        if (count == 0 || count > 0xFFFF) return false;
+
+        uint8_t* bytes = (uint8_t*)m_database.m_arena.allocate(count * 2, 1);
+        memcpy(bytes, m_signatureBytes.data(), count);
+        memcpy(bytes + count, m_signatureMask.data(), count);
+        m_signature = bytes;
+        m_signatureLength = (uint16_t)count;
+        return true;
+    }
+
+    bool addEntry() {
+        if (!m_hasName) return fail("missing name");
+        if (!m_hasOffset) return fail("missing offset");
+        if (!m_hasModule) return fail("missing module");
+        OffsetRecord* record = (OffsetRecord*)m_database.m_arena.allocate(sizeof(OffsetRecord), alignof(OffsetRecord));
+        record->nameHash = m_nameHash;
+        record->offset = m_offset;
+        record->signature = m_signature;
+        record->signatureLength = m_signatureLength;
+        record->module = (uint16_t)m_module;
+        if (m_moduleIsName)
+            m_namedModuleRecords.push_back(record);
+        else
+            m_maxModuleIndex = std::max(m_maxModuleIndex, m_module);
+        m_database.m_records.push_back(record);
+        m_entryCount++;
+        resetEntry();
+        return true;
+    }
+
+    void resetEntry() {
+        m_nameHash = 0;
+        m_offset = 0;
+        m_signature = nullptr;
+        m_signatureLength = 0;
+        m_module = 0;
+        m_moduleIsName = false;
+        m_hasName = false;
+        m_hasOffset = false;
+        m_hasModule = false;
+    }
+
+    OffsetDatabase& m_database;
+    int m_depth;
+    int m_skipDepth;        // Depth of the skipped value, 0 when not skipping
+    Section m_section;
+    Field m_field;
+    int m_entryCount;
+    std::string m_error;
+
+    // Entry being read
+    uint64_t m_nameHash;
+    uint64_t m_offset;
+    const uint8_t* m_signature;
+    uint16_t m_signatureLength;
+    int m_module;               // Index in "modules", or in m_moduleNames when m_moduleIsName
+    bool m_moduleIsName;
+    bool m_hasName;
+    bool m_hasOffset;
+    bool m_hasModule;
+
+    // Modules of the entries, resolved by resolveModules(): the largest index given as a number, and the records
+    // that named their module, holding an index in m_moduleNames until then
+    int m_maxModuleIndex;
+    std::vector<std::string> m_moduleNames;
+    std::vector<OffsetRecord*> m_namedModuleRecords;
+
+    // parseSignature() buffers, kept between entries
+    std::vector<uint8_t> m_signatureBytes;
+    std::vector<uint8_t> m_signatureMask;
+};
+
+// Constructor
+OffsetDatabase::OffsetDatabase()
+    : m_arena(ARENA_CHUNK_SIZE)
+{
+}
+
+void OffsetDatabase::clear() {
+    m_records.clear();
+    m_modules.clear();
+    m_arena.reset();
+}
+
+// Streamed through the stream buffer: the file is never held in memory as a whole
+bool OffsetDatabase::loadFile(const char* path, std::string* error) {
+    clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (error) *error = std::string("cannot open ") + path;
+        return false;
+    }
+    OffsetDatabaseSax sax(*this);
+    const bool parsed = nlohmann::json::sax_parse(file, &sax) && sax.resolveModules();
+    return finishLoad(parsed, sax.getError(), error);
+}
+
+bool OffsetDatabase::loadMemory(const char* data, size_t size, std::string* error) {
+    clear();
+    OffsetDatabaseSax sax(*this);
+    const bool parsed = nlohmann::json::sax_parse(data, data + size, &sax) && sax.resolveModules();
+    return finishLoad(parsed, sax.getError(), error);
+}
+
+// Check module indices and sort the index, or clear everything on failure
+bool OffsetDatabase::finishLoad(bool parsed, std::string message, std::string* error) {
+    bool loaded = parsed;
+    if (loaded) {
+        for (const OffsetRecord* record : m_records) {
+            if (record->module >= m_modules.size()) {
+                message = "module index out of range";
+                loaded = false;
+                break;
+            }
+        }
+    }
+    if (!loaded) {
+        clear();
+        if (error) *error = message;
+        return false;
+    }
+
+    // Equal names keep the file order, find() returns the first one
+    std::stable_sort(m_records.begin(), m_records.end(), [](const OffsetRecord* lhs, const OffsetRecord* rhs) {
+        return lhs->nameHash < rhs->nameHash;
+    });
+    m_records.shrink_to_fit();
+    return true;
+}
+
+const OffsetRecord* OffsetDatabase::find(const char* name) const {
+    const uint64_t hash = hashName(name, strlen(name));
+    auto it = std::lower_bound(m_records.begin(), m_records.end(), hash, [](const OffsetRecord* record, uint64_t value) {
+        return record->nameHash < value;
+    });
+    return it != m_records.end() && (*it)->nameHash == hash ? *it : nullptr;
+}
+
+int OffsetDatabase::getRecordCount() const {
+    return (int)m_records.size();
+}
+
+const OffsetRecord& OffsetDatabase::getRecord(int index) const {
+    return *m_records[index];
+}
+
+int OffsetDatabase::getModuleCount() const {
+    return (int)m_modules.size();
+}
+
+const char* OffsetDatabase::getModuleName(int module) const {
+    return m_modules[module];
+}
+
+bool OffsetDatabase::matchSignature(const OffsetRecord& record, const uint8_t* address) {
+    const uint8_t* mask = record.signature + record.signatureLength;
+    for (int n = 0; n < record.signatureLength; n++)
+        if ((address[n] & mask[n]) != record.signature[n])
+            return false;
+    return true;
+}
+
+// memchr() on the first byte that is not a wildcard, then a full compare at each candidate
+const uint8_t* OffsetDatabase::scanSignature(const OffsetRecord& record, const uint8_t* start, size_t length) {
+    const size_t count = record.signatureLength;
+    if (count == 0 || length < count) return nullptr;
+    const uint8_t* mask = record.signature + count;
+    size_t anchor = 0;
+    while (anchor < count && mask[anchor] == 0) anchor++;
+    const uint8_t* last = start + length - count;
+    if (anchor == count) return start;
+
+    for (const uint8_t* p = start + anchor; p <= last + anchor;) {
+        p = (const uint8_t*)memchr(p, record.signature[anchor], (size_t)(last + anchor - p) + 1);
+        if (!p) return nullptr;
+        if (matchSignature(record, p - anchor)) return p - anchor;
+        p++;
+    }
+    return nullptr;
+}
+
+uint64_t OffsetDatabase::hashName(const char* name, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t n = 0; n < length; n++) {
+        hash ^= (uint8_t)name[n];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+const MonotonicArena& OffsetDatabase::getArena() const {
+    return m_arena;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "MonotonicArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Offset and signature record of a OffsetDatabase, 32 bytes
+ */
+struct OffsetRecord {
+    uint64_t nameHash;          // OffsetDatabase::hashName() of the name, names themselves are not kept
+    uint64_t offset;            // Relative to the module base
+    const uint8_t* signature;   // 'signatureLength' bytes, then as many mask bytes (0xFF compare, 0x00 wildcard)
+    uint16_t signatureLength;   // 0 if the record has no signature
+    uint16_t module;            // Index in OffsetDatabase::getModuleName()
+};
+
+/**
+ * Per-game offset / signature database, streamed from JSON without building a DOM
+ * The file is streamed through nlohmann::json::sax_parse(): records go straight into compact OffsetRecord structs
+ * in one MonotonicArena, and the only other allocation is the index sorted by name hash.
+ * Format (unknown keys are skipped, "modules" is optional and may come after "entries"):
+ *   {
+ *     "modules": ["libil2cpp.so", "libunity.so"],
+ *     "entries": [
+ *       { "name": "PlayerController.get_Health", "module": 0, "offset": "0x1A2B3C", "signature": "FF 43 01 D1 ?? ?? 00 94" },
+ *       { "name": "Camera.get_main", "module": "libil2cpp.so", "offset": 1715004 }
+ *     ]
+ *   }
+ * "name", "module" and "offset" are required. "module" is an index in "modules" or a module name (added after the
+ * listed ones if missing), "offset" a number or a string (decimal or 0x hex), "signature" hex bytes with '?' or '??'
+ * for wildcards, like find_pattern() in Utils.h.
+ */
+class OffsetDatabase {
+public:
+    OffsetDatabase();
+
+    // Replace the content with a file / a JSON text. On failure the database is empty and 'error' says why
+    bool loadFile(const char* path, std::string* error = nullptr);
+    bool loadMemory(const char* data, size_t size, std::string* error = nullptr);
+
+    // Drop every record
+    void clear();
+
+    // Record of a name, NULL if there is none
+    const OffsetRecord* find(const char* name) const;
+
+    // Records sorted by name hash
+    int getRecordCount() const;
+    const OffsetRecord& getRecord(int index) const;
+
+    int getModuleCount() const;
+    const char* getModuleName(int module) const;
+
+    // Whether the bytes at 'address' match the record signature
+    static bool matchSignature(const OffsetRecord& record, const uint8_t* address);
+
+    // First match of the record signature in [start, start + length), NULL if none
+    static const uint8_t* scanSignature(const OffsetRecord& record, const uint8_t* start, size_t length);
+
+    // 64-bit FNV-1a, collisions are negligible for a few million names
+    static uint64_t hashName(const char* name, size_t length);
+
+    // Memory used by the records and signatures
+    const MonotonicArena& getArena() const;
+
+private:
+    // Disable copy constructor and assignment
+    OffsetDatabase(const OffsetDatabase&) = delete;
+    OffsetDatabase& operator=(const OffsetDatabase&) = delete;
+
+    friend class OffsetDatabaseSax;
+
+    bool finishLoad(bool parsed, std::string message, std::string* error);
+
+    MonotonicArena m_arena;
+    std::vector<const OffsetRecord*> m_records;     // Sorted by name hash
+    std::vector<const char*> m_modules;             // In the arena
+};
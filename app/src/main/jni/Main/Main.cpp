@@ -12,7 +12,9 @@
 #include "../Include/Unity.h"
 
 void DrawMenu() {
+#ifndef IMGUI_DISABLE_DEMO_WINDOWS
     ImGui::ShowDemoWindow();
+#endif
     
     // Demo of soft keyboard integration
     static std::string textInput = "Type here...";
@@ -32,13 +34,13 @@ void DrawMenu() {
     }
     
     // Keyboard control buttons
-    if (ImGui::Button("Show Keyboard")) {
+    if (ImGui::Button(IM_STATIC_ID("Show Keyboard"))) {
         ImGui::ShowSoftKeyboard();
     }
     
     ImGui::SameLine();
     
-    if (ImGui::Button("Hide Keyboard")) {
+    if (ImGui::Button(IM_STATIC_ID("Hide Keyboard"))) {
         ImGui::HideSoftKeyboard();
     }
     
@@ -52,6 +54,13 @@ void DrawMenu() {
     
     ImGui::Separator();
     
+    // Values kept across launches
+    ImGuiConfig& config = ImGuiConfig::getInstance();
+    ImGui::Checkbox(IM_STATIC_ID("Saved Toggle"), &config.getBool("example.toggle"));
+    ImGui::SliderFloat(IM_STATIC_ID("Saved Slider"), &config.getFloat("example.slider", 0.5f), 0.0f, 1.0f);
+    
+    ImGui::Separator();
+    
     // Add tabs for different examples
     if (ImGui::BeginTabBar("SoftKeyboardExamples")) {
         if (ImGui::BeginTabItem("Basic Demo")) {
@@ -116,14 +125,30 @@ extern "C" {
             } else {
                 LOGE("Failed to register soft keyboard JNI methods");
             }
+            
+            // Directory of the saved menu config, and the save on pause
+            if (!ImGuiConfig::setFilesDir(env)) {
+                LOGE("Failed to get the app files directory");
+            }
+            if (!ImGuiConfig::registerJNIMethods(env)) {
+                LOGE("Failed to register config JNI methods");
+            }
         }
 
         return JNI_VERSION_1_6;
     }
 }
 
+// Defined by the replay harness (Replay/ModMenuReplay.cpp), which does its own setup and must not hook anything.
+// A weak reference instead of a define: the harness compiles this file exactly as libModMenu.so does, so the PGO
+// profile it writes matches the shipped code. Null in libModMenu.so
+extern "C" __attribute__((weak)) const bool g_modMenuReplay;
+
 __attribute__((constructor))
 void init() {
+    if (&g_modMenuReplay)
+        return;
+
     LOGI("Loaded Mod Menu");
 
     // Initialize soft keyboard
@@ -0,0 +1,130 @@
+//
+// Replay harness for the menu frame loop, built by Android.mk when MODMENU_REPLAY=1 (see build_pgo.sh)
+// Linked with the libModMenu.so sources compiled with the same flags, this file and SoftGL are the only additions.
+// Runs swapbuffers_hook() for a fixed number of frames on SoftGL with a scripted touch sequence, then prints frame
+// time statistics. Built with MODMENU_PGO=generate, it writes the profile used by the MODMENU_PGO=use build.
+// Usage: ModMenuReplay [frames] [width] [height]
+//
+
+#include "SoftGL.h"
+#include "../Include/ImGui/imgui.h"
+#include "../Include/ImGuiSoftKeyboard.h"
+#include <EGL/egl.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <time.h>
+#include <vector>
+
+// Makes init() in Main.cpp return before it hooks anything
+extern "C" const bool g_modMenuReplay = true;
+
+// Defined in Main.cpp (through ImGui.h)
+extern void (*menuAddress)();
+extern EGLBoolean (*o_swapbuffers)(EGLDisplay dpy, EGLSurface surf);
+EGLBoolean swapbuffers_hook(EGLDisplay dpy, EGLSurface surf);
+void DrawMenu();
+
+// Frames dropped from the statistics: font atlas upload, first layout passes
+static const int WARMUP_FRAMES = 60;
+
+// One touch: press at 'from', slide to 'to' while held, release, then stay idle a frame
+struct Gesture {
+    ImVec2 from;
+    ImVec2 to;
+    int holdFrames;
+    float wheel;
+};
+
+// Stands in for the real eglSwapBuffers() behind the hook
+static EGLBoolean replaySwapBuffers(EGLDisplay dpy, EGLSurface surf) {
+    return EGL_TRUE;
+}
+
+// Deterministic mix of taps (tabs, buttons, input fields), drags and wheel scrolls over the menu area
+static std::vector<Gesture> makeGestures(int count, float width, float height) {
+    std::vector<Gesture> gestures;
+    unsigned int seed = 12345;
+    auto next = [&seed](float max) {
+        seed = seed * 1664525u + 1013904223u;
+        return (float)(seed >> 8) / (float)(1 << 24) * max;
+    };
+    const float areaWidth = std::min(width, 1000.0f);
+    const float areaHeight = std::min(height, 1000.0f);
+    for (int n = 0; n < count; n++) {
+        Gesture gesture;
+        gesture.from = ImVec2(next(areaWidth), next(areaHeight));
+        gesture.to = gesture.from;
+        gesture.holdFrames = 2;
+        gesture.wheel = 0.0f;
+        if (n % 5 == 3) {
+            gesture.to = ImVec2(next(areaWidth), next(areaHeight));
+            gesture.holdFrames = 12;
+        } else if (n % 7 == 5) {
+            gesture.wheel = (n % 2) ? -1.0f : 1.0f;
+        }
+        gestures.push_back(gesture);
+    }
+    return gestures;
+}
+
+static long long nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : 3000;
+    const int width = argc > 2 ? atoi(argv[2]) : 2400;
+    const int height = argc > 3 ? atoi(argv[3]) : 1080;
+
+    // Same setup as init() and initModMenu(), minus the hooks
+    g_softKeyboard = &ImGuiSoftKeyboard::getInstance();
+    g_softKeyboard->initialize();
+    menuAddress = DrawMenu;
+    o_swapbuffers = replaySwapBuffers;
+    softGLSetSurfaceSize(width, height);
+
+    const std::vector<Gesture> gestures = makeGestures(64, (float)width, (float)height);
+    std::vector<double> frameTimes;
+    frameTimes.reserve(frames);
+    int gestureIndex = 0;
+    int gestureFrame = 0;
+    for (int frame = 0; frame < WARMUP_FRAMES + frames; frame++) {
+        // Input for this frame, queued once the context exists
+        if (ImGui::GetCurrentContext()) {
+            ImGuiIO& io = ImGui::GetIO();
+            const Gesture& gesture = gestures[gestureIndex];
+            const float t = gesture.holdFrames > 1 ? (float)std::min(gestureFrame, gesture.holdFrames - 1) / (gesture.holdFrames - 1) : 1.0f;
+            io.AddMousePosEvent(gesture.from.x + (gesture.to.x - gesture.from.x) * t, gesture.from.y + (gesture.to.y - gesture.from.y) * t);
+            if (gestureFrame == 0) {
+                io.AddMouseButtonEvent(0, true);
+                if (gesture.wheel != 0.0f)
+                    io.AddMouseWheelEvent(0.0f, gesture.wheel);
+            } else if (gestureFrame == gesture.holdFrames) {
+                io.AddMouseButtonEvent(0, false);
+            }
+            if (++gestureFrame > gesture.holdFrames + 1) {
+                gestureFrame = 0;
+                gestureIndex = (gestureIndex + 1) % (int)gestures.size();
+            }
+        }
+
+        const long long start = nowNs();
+        swapbuffers_hook((EGLDisplay)1, (EGLSurface)1);
+        if (frame >= WARMUP_FRAMES)
+            frameTimes.push_back((nowNs() - start) / 1000.0);
+    }
+
+    if (frameTimes.empty())
+        return 1;
+    double total = 0.0;
+    for (double time : frameTimes)
+        total += time;
+    std::sort(frameTimes.begin(), frameTimes.end());
+    auto percentile = [&frameTimes](double p) { return frameTimes[(size_t)(p * (frameTimes.size() - 1))]; };
+    printf("frames=%d mean=%.1f p50=%.1f p95=%.1f p99=%.1f draws=%llu (base vertex %llu)\n", (int)frameTimes.size(), total / frameTimes.size(),
+           percentile(0.50), percentile(0.95), percentile(0.99), softGLGetDrawCalls(), softGLGetBaseVertexDrawCalls());
+    return 0;
+}
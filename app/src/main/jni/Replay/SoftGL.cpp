@@ -0,0 +1,341 @@
+//
+// Software stand-in for the GLES3 and EGL entry points used by the menu, linked into the replay harness instead of
+// the driver so the frame loop runs without a display or a GL context.
+// Buffer and texture uploads are copied and draw calls walk their indices, which is the CPU side work of a real
+// driver. Nothing is rasterized. Like current drivers, it reports GLES 3.2 and resolves glDrawElementsBaseVertex()
+// through eglGetProcAddress(), so the backend takes the same draw path as on devices.
+//
+
+#include "SoftGL.h"
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+    struct SoftGLState {
+        int surfaceWidth = 0;
+        int surfaceHeight = 0;
+        GLuint nextName = 1;
+        std::map<GLuint, std::vector<unsigned char>> buffers;
+        std::map<GLuint, std::vector<unsigned char>> textures;
+        std::map<GLenum, bool> enabled;
+        GLint activeTexture = GL_TEXTURE0;
+        GLint program = 0;
+        GLint texture2D = 0;
+        GLint arrayBuffer = 0;
+        GLint elementBuffer = 0;
+        GLint vertexArray = 0;
+        GLint viewport[4] = {};
+        GLint scissor[4] = {};
+        GLint blendSrcRgb = GL_ONE, blendDstRgb = GL_ZERO, blendSrcAlpha = GL_ONE, blendDstAlpha = GL_ZERO;
+        GLint blendEquationRgb = GL_FUNC_ADD, blendEquationAlpha = GL_FUNC_ADD;
+        unsigned long long drawCalls = 0;
+        unsigned long long baseVertexDrawCalls = 0;
+        unsigned long long indexChecksum = 0;
+    };
+
+    SoftGLState& state() {
+        static SoftGLState instance;
+        return instance;
+    }
+
+    std::vector<unsigned char>* boundBuffer(GLenum target) {
+        SoftGLState& gl = state();
+        const GLuint name = (target == GL_ELEMENT_ARRAY_BUFFER) ? gl.elementBuffer : gl.arrayBuffer;
+        auto it = gl.buffers.find(name);
+        return it != gl.buffers.end() ? &it->second : nullptr;
+    }
+
+    // Walk the indices of a draw call, rejected like a GL_INVALID_OPERATION when they overrun the element buffer
+    bool drawIndices(GLsizei count, GLenum type, const void* indices, GLint baseVertex) {
+        SoftGLState& gl = state();
+        const std::vector<unsigned char>* buffer = boundBuffer(GL_ELEMENT_ARRAY_BUFFER);
+        if (!buffer)
+            return false;
+        const size_t indexSize = (type == GL_UNSIGNED_INT) ? 4 : 2;
+        const size_t offset = (size_t)indices;
+        if (offset + count * indexSize > buffer->size())
+            return false;
+        unsigned long long checksum = 0;
+        for (GLsizei i = 0; i < count; i++) {
+            const unsigned char* index = buffer->data() + offset + i * indexSize;
+            checksum += ((indexSize == 4) ? *(const GLuint*)index : *(const GLushort*)index) + baseVertex;
+        }
+        gl.indexChecksum += checksum;
+        gl.drawCalls++;
+        return true;
+    }
+
+    void genNames(GLsizei n, GLuint* names, std::map<GLuint, std::vector<unsigned char>>* objects) {
+        for (GLsizei i = 0; i < n; i++) {
+            names[i] = state().nextName++;
+            if (objects)
+                (*objects)[names[i]];
+        }
+    }
+}
+
+// Size returned by eglQuerySurface()
+void softGLSetSurfaceSize(int width, int height) {
+    state().surfaceWidth = width;
+    state().surfaceHeight = height;
+}
+
+unsigned long long softGLGetDrawCalls() {
+    return state().drawCalls;
+}
+
+unsigned long long softGLGetBaseVertexDrawCalls() {
+    return state().baseVertexDrawCalls;
+}
+
+// EGL
+EGLBoolean eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint* value) {
+    if (attribute == EGL_WIDTH)
+        *value = state().surfaceWidth;
+    else if (attribute == EGL_HEIGHT)
+        *value = state().surfaceHeight;
+    else
+        return EGL_FALSE;
+    return EGL_TRUE;
+}
+
+// GLES 3.2 core (the backend only asks for the EXT/OES variants below 3.2)
+static void GL_APIENTRY softGLDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex) {
+    if (drawIndices(count, type, indices, basevertex))
+        state().baseVertexDrawCalls++;
+}
+
+// The only extension entry point is glDrawElementsBaseVertex()
+__eglMustCastToProperFunctionPointerType eglGetProcAddress(const char* procname) {
+    if (strcmp(procname, "glDrawElementsBaseVertex") == 0)
+        return (__eglMustCastToProperFunctionPointerType)softGLDrawElementsBaseVertex;
+    return nullptr;
+}
+
+// Strings and state queries
+const GLubyte* glGetString(GLenum name) {
+    return (const GLubyte*)(name == GL_VERSION ? "OpenGL ES 3.2 SoftGL" : "SoftGL");
+}
+
+const GLubyte* glGetStringi(GLenum name, GLuint index) {
+    return (const GLubyte*)"";
+}
+
+void glGetIntegerv(GLenum pname, GLint* data) {
+    SoftGLState& gl = state();
+    switch (pname) {
+    case GL_MAJOR_VERSION: *data = 3; break;
+    case GL_MINOR_VERSION: *data = 2; break;
+    case GL_NUM_EXTENSIONS: *data = 0; break;
+    case GL_ACTIVE_TEXTURE: *data = gl.activeTexture; break;
+    case GL_CURRENT_PROGRAM: *data = gl.program; break;
+    case GL_TEXTURE_BINDING_2D: *data = gl.texture2D; break;
+    case GL_ARRAY_BUFFER_BINDING: *data = gl.arrayBuffer; break;
+    case GL_ELEMENT_ARRAY_BUFFER_BINDING: *data = gl.elementBuffer; break;
+    case GL_VERTEX_ARRAY_BINDING: *data = gl.vertexArray; break;
+    case GL_VIEWPORT: memcpy(data, gl.viewport, sizeof(gl.viewport)); break;
+    case GL_SCISSOR_BOX: memcpy(data, gl.scissor, sizeof(gl.scissor)); break;
+    case GL_BLEND_SRC_RGB: *data = gl.blendSrcRgb; break;
+    case GL_BLEND_DST_RGB: *data = gl.blendDstRgb; break;
+    case GL_BLEND_SRC_ALPHA: *data = gl.blendSrcAlpha; break;
+    case GL_BLEND_DST_ALPHA: *data = gl.blendDstAlpha; break;
+    case GL_BLEND_EQUATION_RGB: *data = gl.blendEquationRgb; break;
+    case GL_BLEND_EQUATION_ALPHA: *data = gl.blendEquationAlpha; break;
+    default: *data = 0; break;
+    }
+}
+
+void glEnable(GLenum cap) {
+    state().enabled[cap] = true;
+}
+
+void glDisable(GLenum cap) {
+    state().enabled[cap] = false;
+}
+
+GLboolean glIsEnabled(GLenum cap) {
+    return state().enabled[cap] ? GL_TRUE : GL_FALSE;
+}
+
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    GLint* viewport = state().viewport;
+    viewport[0] = x; viewport[1] = y; viewport[2] = width; viewport[3] = height;
+}
+
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    GLint* scissor = state().scissor;
+    scissor[0] = x; scissor[1] = y; scissor[2] = width; scissor[3] = height;
+}
+
+void glBlendEquation(GLenum mode) {
+    state().blendEquationRgb = state().blendEquationAlpha = mode;
+}
+
+void glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    state().blendEquationRgb = modeRGB;
+    state().blendEquationAlpha = modeAlpha;
+}
+
+void glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    SoftGLState& gl = state();
+    gl.blendSrcRgb = sfactorRGB; gl.blendDstRgb = dfactorRGB;
+    gl.blendSrcAlpha = sfactorAlpha; gl.blendDstAlpha = dfactorAlpha;
+}
+
+void glPixelStorei(GLenum pname, GLint param) {
+}
+
+// Shaders always compile and link, attributes and uniforms get fixed locations
+GLuint glCreateShader(GLenum type) {
+    return state().nextName++;
+}
+
+void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+}
+
+void glCompileShader(GLuint shader) {
+}
+
+void glGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    if (length)
+        *length = 0;
+    if (bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+void glDeleteShader(GLuint shader) {
+}
+
+GLuint glCreateProgram() {
+    return state().nextName++;
+}
+
+void glAttachShader(GLuint program, GLuint shader) {
+}
+
+void glDetachShader(GLuint program, GLuint shader) {
+}
+
+void glLinkProgram(GLuint program) {
+}
+
+void glGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+    *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+}
+
+void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    if (length)
+        *length = 0;
+    if (bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+void glDeleteProgram(GLuint program) {
+}
+
+void glUseProgram(GLuint program) {
+    state().program = program;
+}
+
+GLint glGetAttribLocation(GLuint program, const GLchar* name) {
+    const std::string attribute = name;
+    return attribute == "Position" ? 0 : attribute == "UV" ? 1 : attribute == "Color" ? 2 : -1;
+}
+
+GLint glGetUniformLocation(GLuint program, const GLchar* name) {
+    const std::string uniform = name;
+    return uniform == "Texture" ? 0 : uniform == "ProjMtx" ? 1 : -1;
+}
+
+void glUniform1i(GLint location, GLint v0) {
+}
+
+void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+}
+
+// Buffers and vertex arrays
+void glGenBuffers(GLsizei n, GLuint* buffers) {
+    genNames(n, buffers, &state().buffers);
+}
+
+void glDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    for (GLsizei i = 0; i < n; i++)
+        state().buffers.erase(buffers[i]);
+}
+
+void glBindBuffer(GLenum target, GLuint buffer) {
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+        state().elementBuffer = buffer;
+    else
+        state().arrayBuffer = buffer;
+}
+
+void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    std::vector<unsigned char>* buffer = boundBuffer(target);
+    if (!buffer)
+        return;
+    buffer->resize(size);
+    if (data)
+        memcpy(buffer->data(), data, size);
+}
+
+void glGenVertexArrays(GLsizei n, GLuint* arrays) {
+    genNames(n, arrays, nullptr);
+}
+
+void glDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+}
+
+void glBindVertexArray(GLuint array) {
+    state().vertexArray = array;
+}
+
+void glEnableVertexAttribArray(GLuint index) {
+}
+
+void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+}
+
+// Textures
+void glGenTextures(GLsizei n, GLuint* textures) {
+    genNames(n, textures, &state().textures);
+}
+
+void glDeleteTextures(GLsizei n, const GLuint* textures) {
+    for (GLsizei i = 0; i < n; i++)
+        state().textures.erase(textures[i]);
+}
+
+void glActiveTexture(GLenum texture) {
+    state().activeTexture = texture;
+}
+
+void glBindTexture(GLenum target, GLuint texture) {
+    state().texture2D = texture;
+}
+
+void glTexParameteri(GLenum target, GLenum pname, GLint param) {
+}
+
+void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+    auto it = state().textures.find(state().texture2D);
+    if (it == state().textures.end())
+        return;
+    const size_t size = (size_t)width * height * 4;
+    it->second.resize(size);
+    if (pixels)
+        memcpy(it->second.data(), pixels, size);
+}
+
+// Draw calls validate their indices against the bound element buffer
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    drawIndices(count, type, indices, 0);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// Software GLES3/EGL stand-in used by the replay harness, see SoftGL.cpp
+
+// Size returned by eglQuerySurface()
+void softGLSetSurfaceSize(int width, int height);
+
+// Draw calls issued since startup, and how many of them went through glDrawElementsBaseVertex()
+unsigned long long softGLGetDrawCalls();
+unsigned long long softGLGetBaseVertexDrawCalls();
@@ -0,0 +1,90 @@
+#!/bin/bash
+
+# Host benchmarks of the Dear ImGui changes under app/src/main/jni/Include/ImGui
+# Builds each app/src/main/jni/Bench/<Name>Bench.cpp with the host compiler against the vendored ImGui sources and runs it.
+# Usage: ./bench_imgui.sh [Name...]    (default: all of them)
+#   TextLayout    glyph run cache of ImFont::RenderText() / CalcTextSizeA()
+#   IdHash        ImHashStr() with the lookup table, the default backend and CRC32C instructions
+#   Storage       ImGuiStorage sorted vector vs hash index, 100 / 10k / 100k keys
+#   TableSorter   ImGuiTableSorter::sortIndices() vs std::stable_sort, and update() on a 200k row table
+#   VirtualTable  ImGuiVirtualTable::draw() while scrolling 100k / 1M rows, unsorted and sorted
+#   StreamingPlot ImGuiStreamingPlot min/max checked against brute force, per-frame cost of a 1M sample plot
+#   Autocomplete  ImGuiAutocomplete::query() while typing in 200k names, results checked against brute force
+
+CXX=${CXX:-c++}
+JNI_DIR="app/src/main/jni"
+IMGUI_DIR="$JNI_DIR/Include/ImGui"
+OUT_DIR="app/build/bench"
+BENCHES=${*:-"TextLayout IdHash Storage TableSorter VirtualTable StreamingPlot Autocomplete"}
+
+# Check if we're in the right directory
+if [ ! -f "app/build.gradle" ]; then
+    echo "Error: Please run this script from the project root directory"
+    exit 1
+fi
+
+mkdir -p "$OUT_DIR"
+
+# build <output> <extra flags> <sources...>: ImGui core sources are always linked in
+build() {
+    local OUTPUT=$1
+    local FLAGS=$2
+    shift 2
+    echo "Building $OUTPUT..."
+    "$CXX" -std=c++17 -O2 $FLAGS -I"$IMGUI_DIR" -o "$OUT_DIR/$OUTPUT" "$@" \
+        "$IMGUI_DIR/imgui.cpp" "$IMGUI_DIR/imgui_draw.cpp" "$IMGUI_DIR/imgui_widgets.cpp" "$IMGUI_DIR/imgui_tables.cpp" -lpthread
+    if [ $? -ne 0 ]; then
+        echo "Build failed!"
+        exit 1
+    fi
+}
+
+STATUS=0
+for BENCH in $BENCHES; do
+    echo ""
+    case $BENCH in
+        TextLayout)
+            build TextLayoutBench "" "$JNI_DIR/Bench/TextLayoutBench.cpp"
+            "$OUT_DIR/TextLayoutBench" || STATUS=1
+            ;;
+        IdHash)
+            # CRC32C needs the instructions: SSE4.2 on x86-64, the CRC extension on arm64
+            case $(uname -m) in
+                aarch64|arm64) CRC_FLAGS="-march=armv8-a+crc" ;;
+                *) CRC_FLAGS="-msse4.2" ;;
+            esac
+            build IdHashBench_table "-DIMGUI_DISABLE_HW_CRC32" "$JNI_DIR/Bench/IdHashBench.cpp"
+            build IdHashBench_default "$CRC_FLAGS" "$JNI_DIR/Bench/IdHashBench.cpp"
+            build IdHashBench_crc32c "$CRC_FLAGS -DIMGUI_USE_CRC32C" "$JNI_DIR/Bench/IdHashBench.cpp"
+            for VARIANT in table default crc32c; do
+                echo "[$VARIANT]"
+                "$OUT_DIR/IdHashBench_$VARIANT" || STATUS=1
+            done
+            ;;
+        Storage)
+            build StorageBench "" "$JNI_DIR/Bench/StorageBench.cpp"
+            "$OUT_DIR/StorageBench" || STATUS=1
+            ;;
+        TableSorter)
+            build TableSorterBench "" "$JNI_DIR/Bench/TableSorterBench.cpp" "$JNI_DIR/Include/ImGuiTableSorter.cpp"
+            "$OUT_DIR/TableSorterBench" || STATUS=1
+            ;;
+        VirtualTable)
+            build VirtualTableBench "" "$JNI_DIR/Bench/VirtualTableBench.cpp" "$JNI_DIR/Include/ImGuiVirtualTable.cpp" "$JNI_DIR/Include/ImGuiTableSorter.cpp"
+            "$OUT_DIR/VirtualTableBench" || STATUS=1
+            ;;
+        StreamingPlot)
+            build StreamingPlotBench "" "$JNI_DIR/Bench/StreamingPlotBench.cpp" "$JNI_DIR/Include/ImGuiStreamingPlot.cpp"
+            "$OUT_DIR/StreamingPlotBench" || STATUS=1
+            ;;
+        Autocomplete)
+            build AutocompleteBench "" "$JNI_DIR/Bench/AutocompleteBench.cpp" "$JNI_DIR/Include/ImGuiAutocomplete.cpp" "$JNI_DIR/Include/ImGuiTableSorter.cpp"
+            "$OUT_DIR/AutocompleteBench" || STATUS=1
+            ;;
+        *)
+            echo "Unknown benchmark: $BENCH"
+            STATUS=1
+            ;;
+    esac
+done
+exit $STATUS
@@ -0,0 +1,45 @@
+#!/bin/bash
+
+# Host benchmark of the offset database loader (app/src/main/jni/Include/OffsetDatabase.cpp)
+# Builds app/src/main/jni/Bench/OffsetDatabaseBench.cpp with the host compiler, generates a database of SIZE_MB
+# megabytes and compares parse time and peak RSS of the SAX loader against full nlohmann::json and ArenaJson DOM parses.
+# Usage: ./bench_offsets.sh [database.json]    (an existing database is used as is)
+
+SIZE_MB=${SIZE_MB:-10}
+RUNS=${RUNS:-3}
+CXX=${CXX:-c++}
+JNI_DIR="app/src/main/jni"
+OUT_DIR="app/build/bench"
+
+echo "Building offset database benchmark..."
+
+# Check if we're in the right directory
+if [ ! -f "app/build.gradle" ]; then
+    echo "Error: Please run this script from the project root directory"
+    exit 1
+fi
+
+mkdir -p "$OUT_DIR"
+"$CXX" -std=c++17 -O2 -o "$OUT_DIR/OffsetDatabaseBench" \
+    "$JNI_DIR/Bench/OffsetDatabaseBench.cpp" \
+    "$JNI_DIR/Include/OffsetDatabase.cpp" \
+    "$JNI_DIR/Include/MonotonicArena.cpp"
+if [ $? -ne 0 ]; then
+    echo "Build failed!"
+    exit 1
+fi
+
+DATABASE=$1
+if [ -z "$DATABASE" ]; then
+    DATABASE="$OUT_DIR/offsets_${SIZE_MB}mb.json"
+    [ -f "$DATABASE" ] || "$OUT_DIR/OffsetDatabaseBench" generate "$DATABASE" "$SIZE_MB" || exit 1
+fi
+
+# One process per run, peak RSS is per process
+echo ""
+echo "Parsing $DATABASE, $RUNS runs each:"
+for MODE in sax dom arena; do
+    for RUN in $(seq "$RUNS"); do
+        "$OUT_DIR/OffsetDatabaseBench" $MODE "$DATABASE" || exit 1
+    done
+done
@@ -0,0 +1,130 @@
+#!/bin/bash
+
+# Build script for the lean ModMenu variant
+# Builds libModMenu.so with the default flags and with MODMENU_LEAN=1 (see app/src/main/jni/Build/Android.mk),
+# then compares size, .text, relocations and, when a device is connected through adb, dlopen() time.
+# Usage: ./build_lean.sh [load runs, default 20]
+
+RUNS=${1:-20}
+JNI_DIR="app/src/main/jni"
+OUT_DIR="app/build/lean"
+
+echo "Building lean ModMenu comparison..."
+
+# Check if we're in the right directory
+if [ ! -f "app/build.gradle" ]; then
+    echo "Error: Please run this script from the project root directory"
+    exit 1
+fi
+
+# Locate the NDK
+NDK_VERSION=$(sed -n "s/.*ndkVersion = '\(.*\)'.*/\1/p" app/build.gradle)
+NDK="${ANDROID_NDK_HOME:-$ANDROID_NDK_ROOT}"
+if [ -z "$NDK" ] && [ -n "$ANDROID_HOME" ]; then
+    NDK="$ANDROID_HOME/ndk/$NDK_VERSION"
+fi
+if [ ! -x "$NDK/ndk-build" ]; then
+    echo "Error: NDK not found, set ANDROID_NDK_HOME (expected version $NDK_VERSION)"
+    exit 1
+fi
+TOOLCHAIN=$(echo "$NDK"/toolchains/llvm/prebuilt/*/bin)
+
+# Build one variant in its own output directory
+build_variant() {
+    local name=$1
+    shift
+    echo "Building $name variant..."
+    "$NDK/ndk-build" -j"$(nproc 2>/dev/null || echo 4)" \
+        NDK_PROJECT_PATH="$JNI_DIR" \
+        APP_BUILD_SCRIPT="$JNI_DIR/Build/Android.mk" \
+        NDK_APPLICATION_MK="$JNI_DIR/Build/Application.mk" \
+        NDK_OUT="$OUT_DIR/$name/obj" \
+        NDK_LIBS_OUT="$OUT_DIR/$name/libs" \
+        "$@" > "$OUT_DIR/$name.log" 2>&1
+    if [ $? -ne 0 ]; then
+        echo "Build failed! See $OUT_DIR/$name.log"
+        exit 1
+    fi
+}
+
+mkdir -p "$OUT_DIR"
+build_variant default
+build_variant lean MODMENU_LEAN=1
+
+# Size comparison, on the stripped libraries that end up in the APK
+text_size() {
+    "$TOOLCHAIN/llvm-size" -A "$1" | awk '$1 == ".text" { print $2 }'
+}
+
+reloc_count() {
+    "$TOOLCHAIN/llvm-readelf" --relocations "$1" | grep -c "R_"
+}
+
+echo ""
+printf "%-12s %-8s %12s %12s %8s\n" "ABI" "Variant" "File" ".text" "Relocs"
+for ABI in arm64-v8a armeabi-v7a; do
+    for VARIANT in default lean; do
+        LIB="$OUT_DIR/$VARIANT/libs/$ABI/libModMenu.so"
+        [ -f "$LIB" ] || continue
+        printf "%-12s %-8s %12s %12s %8s\n" "$ABI" "$VARIANT" "$(stat -c %s "$LIB")" "$(text_size "$LIB")" "$(reloc_count "$LIB")"
+    done
+done
+
+# Load time comparison, needs a device
+if ! command -v adb > /dev/null || [ "$(adb get-state 2>/dev/null)" != "device" ]; then
+    echo ""
+    echo "No device connected, skipping the load time comparison."
+    exit 0
+fi
+
+ABI=$(adb shell getprop ro.product.cpu.abi | tr -d '\r')
+case "$ABI" in
+    arm64-v8a) TARGET=aarch64-linux-android24 ;;
+    armeabi-v7a) TARGET=armv7a-linux-androideabi24 ;;
+    *) echo "Unsupported device ABI: $ABI"; exit 0 ;;
+esac
+
+# dlopen() the library the same way Loader.cpp does and print the elapsed time in microseconds.
+# Each run is a fresh process so the library is never already mapped
+cat > "$OUT_DIR/loadtime.c" << 'EOF'
+#include <dlfcn.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+int main(int argc, char** argv) {
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    void* handle = dlopen(argv[1], RTLD_NOW);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!handle) {
+        fprintf(stderr, "%s\n", dlerror());
+        _exit(1);
+    }
+    printf("%ld\n", (long)((t1.tv_sec - t0.tv_sec) * 1000000L + (t1.tv_nsec - t0.tv_nsec) / 1000));
+    _exit(0); // Skip the library destructors, the menu thread is still running
+}
+EOF
+"$TOOLCHAIN/clang" --target=$TARGET -O2 "$OUT_DIR/loadtime.c" -o "$OUT_DIR/loadtime"
+if [ $? -ne 0 ]; then
+    echo "Failed to build the load time probe"
+    exit 1
+fi
+
+DEVICE_DIR=/data/local/tmp/modmenu_lean
+adb shell mkdir -p $DEVICE_DIR > /dev/null
+adb push "$OUT_DIR/loadtime" $DEVICE_DIR/loadtime > /dev/null
+adb shell chmod 755 $DEVICE_DIR/loadtime
+
+echo ""
+echo "dlopen() time on $ABI, median of $RUNS runs:"
+for VARIANT in default lean; do
+    adb push "$OUT_DIR/$VARIANT/libs/$ABI/libModMenu.so" $DEVICE_DIR/libModMenu_$VARIANT.so > /dev/null
+    TIMES=""
+    for RUN in $(seq "$RUNS"); do
+        TIMES="$TIMES $(adb shell $DEVICE_DIR/loadtime $DEVICE_DIR/libModMenu_$VARIANT.so | tr -d '\r')"
+    done
+    MEDIAN=$(echo $TIMES | tr ' ' '\n' | sort -n | awk '{ v[NR] = $1 } END { print v[int((NR + 1) / 2)] }')
+    printf "%-8s %8s us\n" "$VARIANT" "$MEDIAN"
+done
+adb shell rm -r $DEVICE_DIR
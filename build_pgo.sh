@@ -0,0 +1,129 @@
+#!/bin/bash
+
+# Build script for the profile-guided ModMenu variant
+# 1. Builds the replay harness (app/src/main/jni/Replay) instrumented with MODMENU_PGO=generate
+# 2. Runs it on the connected device for each supported ABI and merges the profiles into
+#    app/src/main/jni/Build/pgo/ModMenu-<abi>.profdata
+# 3. Builds libModMenu.so and the harness with MODMENU_PGO=use (profile + ThinLTO) and compares frame times
+#    against the default build
+# Extra arguments are passed to ndk-build, e.g. ./build_pgo.sh MODMENU_LEAN=1
+# Then build the APK with ./gradlew assembleRelease -PmodMenuPgo
+
+FRAMES=${FRAMES:-3000}
+RUNS=${RUNS:-3}
+JNI_DIR="app/src/main/jni"
+OUT_DIR="app/build/pgo"
+PROFILE_DIR="$JNI_DIR/Build/pgo"
+DEVICE_DIR=/data/local/tmp/modmenu_pgo
+
+echo "Building profile-guided ModMenu..."
+
+# Check if we're in the right directory
+if [ ! -f "app/build.gradle" ]; then
+    echo "Error: Please run this script from the project root directory"
+    exit 1
+fi
+
+# Locate the NDK
+NDK_VERSION=$(sed -n "s/.*ndkVersion = '\(.*\)'.*/\1/p" app/build.gradle)
+NDK="${ANDROID_NDK_HOME:-$ANDROID_NDK_ROOT}"
+if [ -z "$NDK" ] && [ -n "$ANDROID_HOME" ]; then
+    NDK="$ANDROID_HOME/ndk/$NDK_VERSION"
+fi
+if [ ! -x "$NDK/ndk-build" ]; then
+    echo "Error: NDK not found, set ANDROID_NDK_HOME (expected version $NDK_VERSION)"
+    exit 1
+fi
+TOOLCHAIN=$(echo "$NDK"/toolchains/llvm/prebuilt/*/bin)
+
+# The harness runs on the device: profiles must come from the same compiler and target as the final build
+if ! command -v adb > /dev/null || [ "$(adb get-state 2>/dev/null)" != "device" ]; then
+    echo "Error: No device connected, the replay harness runs on an arm64-v8a or armeabi-v7a device"
+    exit 1
+fi
+ABIS=""
+for ABI in $(adb shell getprop ro.product.cpu.abilist | tr -d '\r' | tr ',' ' '); do
+    case "$ABI" in
+        arm64-v8a|armeabi-v7a) ABIS="$ABIS $ABI" ;;
+    esac
+done
+if [ -z "$ABIS" ]; then
+    echo "Error: The device supports neither arm64-v8a nor armeabi-v7a"
+    exit 1
+fi
+
+# Build one variant in its own output directory
+build_variant() {
+    local name=$1
+    shift
+    echo "Building $name variant..."
+    "$NDK/ndk-build" -j"$(nproc 2>/dev/null || echo 4)" \
+        NDK_PROJECT_PATH="$JNI_DIR" \
+        APP_BUILD_SCRIPT="$JNI_DIR/Build/Android.mk" \
+        NDK_APPLICATION_MK="$JNI_DIR/Build/Application.mk" \
+        NDK_OUT="$OUT_DIR/$name/obj" \
+        NDK_LIBS_OUT="$OUT_DIR/$name/libs" \
+        MODMENU_REPLAY=1 "$@" > "$OUT_DIR/$name.log" 2>&1
+    if [ $? -ne 0 ]; then
+        echo "Build failed! See $OUT_DIR/$name.log"
+        exit 1
+    fi
+}
+
+# Run the harness of one variant and ABI on the device, prints its statistics line
+run_replay() {
+    local name=$1 abi=$2 env=$3
+    adb push "$OUT_DIR/$name/libs/$abi/ModMenuReplay" $DEVICE_DIR/ModMenuReplay > /dev/null
+    adb shell chmod 755 $DEVICE_DIR/ModMenuReplay
+    adb shell "cd $DEVICE_DIR && $env ./ModMenuReplay $FRAMES" | tr -d '\r'
+}
+
+# Best mean frame time (us) out of RUNS runs, the least disturbed by the rest of the system
+best_mean() {
+    local name=$1 abi=$2 best=""
+    for RUN in $(seq "$RUNS"); do
+        MEAN=$(run_replay "$name" "$abi" | sed -n 's/.*mean=\([0-9.]*\).*/\1/p')
+        best=$(echo "$best $MEAN" | tr ' ' '\n' | grep . | sort -n | head -1)
+    done
+    echo "$best"
+}
+
+mkdir -p "$OUT_DIR" "$PROFILE_DIR"
+adb shell mkdir -p $DEVICE_DIR > /dev/null
+
+# Training run
+build_variant instrumented MODMENU_PGO=generate "$@"
+for ABI in $ABIS; do
+    echo "Collecting profile for $ABI..."
+    adb shell rm -f "$DEVICE_DIR/*.profraw"
+    run_replay instrumented "$ABI" "LLVM_PROFILE_FILE=$DEVICE_DIR/ModMenu-%p.profraw" > /dev/null
+    rm -rf "$OUT_DIR/profraw-$ABI"
+    mkdir -p "$OUT_DIR/profraw-$ABI"
+    for FILE in $(adb shell ls $DEVICE_DIR | tr -d '\r' | grep "\.profraw$"); do
+        adb pull "$DEVICE_DIR/$FILE" "$OUT_DIR/profraw-$ABI/" > /dev/null
+    done
+    "$TOOLCHAIN/llvm-profdata" merge -o "$PROFILE_DIR/ModMenu-$ABI.profdata" "$OUT_DIR/profraw-$ABI"/*.profraw
+    if [ $? -ne 0 ]; then
+        echo "Failed to merge the $ABI profile"
+        exit 1
+    fi
+done
+
+# Default and optimized builds
+build_variant default "$@"
+build_variant optimized MODMENU_PGO=use "$@"
+
+echo ""
+echo "Frame time, best mean of $RUNS runs of $FRAMES frames:"
+printf "%-12s %12s %12s %8s\n" "ABI" "Default" "PGO+LTO" "Delta"
+for ABI in $ABIS; do
+    DEFAULT=$(best_mean default "$ABI")
+    OPTIMIZED=$(best_mean optimized "$ABI")
+    DELTA=$(awk -v a="$DEFAULT" -v b="$OPTIMIZED" 'BEGIN { if (a > 0) printf "%+.1f%%", (b - a) * 100 / a }')
+    printf "%-12s %10s us %10s us %8s\n" "$ABI" "$DEFAULT" "$OPTIMIZED" "$DELTA"
+done
+adb shell rm -r $DEVICE_DIR
+
+echo ""
+echo "Profiles written to $PROFILE_DIR"
+echo "Optimized libraries: $OUT_DIR/optimized/libs"